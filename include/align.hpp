@@ -0,0 +1,17 @@
+#include "main.h"
+
+#ifndef ALIGN_HPP
+#define ALIGN_HPP
+
+//* goal auto align
+// drives to a scoring pose in front of the nearest goal. the goal comes from the odom pose
+// and the goal table in field.hpp, the vision sensor tightens up the heading once the goal
+// is in view. driving() calls this every frame while the button is held.
+
+/// resets the aligner, call when the button is first pressed
+void align_start(void);
+
+/// one 10 ms step, drives the chassis. returns true once lined up.
+bool align_step(void);
+
+#endif
@@ -0,0 +1,200 @@
+//* hot loop allocation watch
+
+//* headers and stuff
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifndef ALLOC_WATCH_HPP
+#define ALLOC_WATCH_HPP
+
+// counts heap allocations per control loop and reports any made inside a realtime_region,
+// with the return address of whoever called operator new (addr2line -e <elf> <address>).
+// off unless built with -DALLOC_WATCH (make ALLOC_WATCH=1 on the brain), then realtime_region
+// is an empty struct and nothing is hooked.
+// the platform decides which counts belong to the calling task or thread:
+//   brain: src/hot_path.cpp, one per register_control_loop()
+//   host:  a thread_local in the sim, see tools/localization_sim.cpp
+// exactly one file per program defines ALLOC_WATCH_HOOKS before including this to get the
+// replacement operator new/delete. -DALLOC_WATCH_STRICT aborts on the first report.
+// it also keeps a size histogram of every allocation, which the heap monitor logs.
+// no pros/okapi in here so the host sims can use it too.
+
+struct alloc_counts
+{
+    const char *name;
+    std::uint32_t total;            // allocations since the loop registered
+    std::uint32_t realtime;         // of those, inside a realtime_region
+    std::uint32_t depth;            // realtime regions we're in right now
+    std::array<void *, 4> sites;    // call sites already reported, so each is reported once
+    std::uint32_t unreported;       // realtime allocations from sites past the table, not reported
+    bool reporting;                 // alloc_watch_report() is running, don't count it
+};
+
+/// allocation sizes: up to 16 bytes, 32, 64 ... 1024, then everything bigger
+constexpr std::size_t alloc_size_bins {8};
+
+constexpr std::size_t alloc_size_bin(std::size_t size)
+{
+    std::size_t bin {0};
+    for (std::size_t limit = 16; bin + 1 < alloc_size_bins && size > limit; limit *= 2)
+        ++bin;
+    return bin;
+}
+
+/// every allocation from any task, by alloc_size_bin(). not locked, so it's approximate.
+inline std::array<std::uint32_t, alloc_size_bins> alloc_sizes {};
+
+/// counts for the calling task/thread, nullptr if it isn't watched. the platform provides this,
+/// and it's called from operator new so it can't allocate.
+alloc_counts *alloc_watch_counts(void);
+
+/// called the first time a site allocates inside a realtime region. the platform provides this.
+void alloc_watch_report(const alloc_counts &counts, void *site, std::size_t size);
+
+#ifdef ALLOC_WATCH
+
+/// the hooks call this for every allocation
+inline void alloc_watch_note(void *site, std::size_t size)
+{
+    ++alloc_sizes[alloc_size_bin(size)];
+
+    alloc_counts *counts {alloc_watch_counts()};
+    if (counts == nullptr || counts->reporting)
+        return;
+
+    ++counts->total;
+    if (counts->depth == 0)
+        return;
+    ++counts->realtime;
+
+    bool added {false};
+    for (void *&seen : counts->sites)
+    {
+        if (seen == site)
+            return;
+        if (seen == nullptr)
+        {
+            seen = site;
+            added = true;
+            break;
+        }
+    }
+
+    // table's full, count it instead of reporting on every allocation
+    if (!added)
+    {
+        ++counts->unreported;
+        return;
+    }
+
+    counts->reporting = true;
+    alloc_watch_report(*counts, site, size);
+    counts->reporting = false;
+
+#ifdef ALLOC_WATCH_STRICT
+    std::abort();
+#endif
+}
+
+/// marks a scope that must not allocate, e.g. the body of a control loop between delays.
+/// nests, and does nothing on a task/thread that isn't watched.
+class realtime_region
+{
+public:
+    realtime_region(void) : m_counts{alloc_watch_counts()}
+    {
+        if (m_counts != nullptr)
+            ++m_counts->depth;
+    }
+
+    ~realtime_region(void)
+    {
+        if (m_counts != nullptr)
+            --m_counts->depth;
+    }
+
+    realtime_region(const realtime_region &) = delete;
+    realtime_region &operator=(const realtime_region &) = delete;
+
+private:
+    alloc_counts *m_counts;
+};
+
+#else
+
+struct realtime_region
+{
+    realtime_region(void) {}    // user provided so an unused one doesn't warn
+};
+
+#endif
+
+#if defined(ALLOC_WATCH) && defined(ALLOC_WATCH_HOOKS)
+
+//* replacement operators
+// the aligned ones aren't replaced, nothing here asks for over-aligned memory
+
+static void *alloc_watch_new(std::size_t size, void *site)
+{
+    alloc_watch_note(site, size);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new(std::size_t size)
+{
+    if (void *p {alloc_watch_new(size, __builtin_return_address(0))})
+        return p;
+#if __cpp_exceptions
+    throw std::bad_alloc{};
+#else
+    std::abort();
+#endif
+}
+
+void *operator new[](std::size_t size)
+{
+    if (void *p {alloc_watch_new(size, __builtin_return_address(0))})
+        return p;
+#if __cpp_exceptions
+    throw std::bad_alloc{};
+#else
+    std::abort();
+#endif
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return alloc_watch_new(size, __builtin_return_address(0));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return alloc_watch_new(size, __builtin_return_address(0));
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
+
+#endif
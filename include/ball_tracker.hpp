@@ -0,0 +1,73 @@
+//* conveyor ball tracking
+
+//* headers and stuff
+#include "robot.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef BALL_TRACKER_HPP
+#define BALL_TRACKER_HPP
+
+// no pros/okapi in here so the host sims can use it.
+
+//* conveyor geometry, inches
+
+constexpr double conveyor_roller_diameter {2.0};
+constexpr double conveyor_per_count {pi * conveyor_roller_diameter / motor_tpr(mechanism_ports::rpm)};
+constexpr double conveyor_split {9.0};     // sensor to where convey_top takes over
+constexpr double conveyor_exit {20.0};     // sensor to where a ball leaves the top
+constexpr double eject_position {15.0};    // where reversing convey_top throws a ball out
+constexpr double ball_diameter {6.3};
+
+enum class ball_color
+{
+    NONE,
+    RED,
+    BLUE
+};
+
+struct tracked_ball
+{
+    double position;        // inches up the conveyor from the optical sensor
+    ball_color color;
+    std::uint32_t seen_ms;  // when it went past the sensor
+};
+
+/// where every ball in the conveyor is. balls enter at 0 (the optical sensor), get moved
+/// up by convey_bot's travel until `split` and by convey_top's travel after that, and drop
+/// off once they're past `exit` (scored) or back below `-fall_out` (spat out the bottom).
+/// index 0 is always the highest ball.
+class ball_tracker
+{
+public:
+    static constexpr std::size_t capacity {4};  // 3 fit in the robot, one spare
+
+    /// per_count converts each stage's encoder counts to inches of conveyor travel
+    ball_tracker(double bot_per_count, double top_per_count, double split, double exit, double fall_out = 3.0);
+
+    /// new encoder readings (absolute, in counts), moves every ball
+    void update(double bot_counts, double top_counts);
+
+    /// a ball just went past the sensor, false if we somehow have no room
+    bool add(ball_color color, std::uint32_t seen_ms);
+
+    /// drops the highest ball, e.g. after ejecting it
+    void pop(void);
+
+    std::size_t size(void) const { return m_count; }
+    const tracked_ball &operator[](std::size_t i) const { return m_balls[(m_head + i) % capacity]; }
+
+private:
+    std::array<tracked_ball, capacity> m_balls;
+    std::size_t m_head {0};
+    std::size_t m_count {0};
+
+    double m_bot_per_count, m_top_per_count;
+    double m_split, m_exit, m_fall_out;
+    double m_last_bot {0.0}, m_last_top {0.0};
+    bool m_primed {false};
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "main.h"
+#include "blog_format.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#ifndef BLOG_HPP
+#define BLOG_HPP
+
+//* deferred formatting binary log
+// BLOG(BLOG_INFO, BLOG_SORTER, "ejected a %s ball at %.1f in", name, position);
+// the robot copies the arguments into a ram buffer and a low priority task writes them to
+// /usd/blog_<n>.bin, the format string is never touched on the robot. decode on the host
+// with tools/blog_decode.cpp and the elf that was running.
+// sites below BLOG_MIN_LEVEL or outside BLOG_CATEGORIES compile to nothing, set them with
+// EXTRA_CXXFLAGS in the Makefile (e.g. -DBLOG_MIN_LEVEL=2 -DBLOG_CATEGORIES=0x21).
+
+#ifndef BLOG_MIN_LEVEL
+#define BLOG_MIN_LEVEL 1    // BLOG_INFO
+#endif
+
+#ifndef BLOG_CATEGORIES
+#define BLOG_CATEGORIES 0xffffffffu
+#endif
+
+constexpr bool blog_enabled(blog_level level, blog_category category)
+{
+    return level >= BLOG_MIN_LEVEL && ((BLOG_CATEGORIES >> category) & 1u) != 0;
+}
+
+#define BLOG(level, category, format, ...)                                                  \
+    do                                                                                      \
+    {                                                                                       \
+        if constexpr (blog_enabled(level, category))                                        \
+        {                                                                                   \
+            static constexpr blog_site blog_site_ {format, __FILE__, __LINE__, level, category}; \
+            blog_emit(&blog_site_, ##__VA_ARGS__);                                          \
+        }                                                                                   \
+    } while (false)
+
+/// starts the task that drains the buffer to the sd card, safe to call more than once.
+/// anything logged before this is kept as long as it fits in the buffer.
+void start_blog(void);
+
+/// records dropped since boot, because the buffer was full or busy
+std::uint32_t blog_dropped(void);
+
+/// copies one finished record into the buffer, used by blog_emit(). never blocks, the
+/// record is dropped if the drain task has the buffer.
+void blog_write(const std::uint8_t *record, std::size_t size);
+
+//* encoding
+
+namespace blog_detail
+{
+    template <typename T>
+    inline std::size_t put(std::uint8_t *out, std::size_t at, blog_tag tag, T value)
+    {
+        if (at + 1 + sizeof(T) > blog_max_payload)
+            return at;
+        out[at] = tag;
+        std::memcpy(out + at + 1, &value, sizeof(T));
+        return at + 1 + sizeof(T);
+    }
+
+    inline std::size_t encode(std::uint8_t *out, std::size_t at, const char *value)
+    {
+        std::size_t size {value == nullptr ? 0 : std::strlen(value)};
+        size = size > blog_max_string ? blog_max_string : size;
+        if (at + 2 + size > blog_max_payload)
+            return at;
+        out[at] = BT_STR;
+        out[at + 1] = static_cast<std::uint8_t>(size);
+        std::memcpy(out + at + 2, value, size);
+        return at + 2 + size;
+    }
+
+    template <typename T>
+    inline std::size_t encode(std::uint8_t *out, std::size_t at, T value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, char *>,
+                      "BLOG takes numbers and c strings");
+
+        if constexpr (std::is_same_v<T, char *>)
+            return encode(out, at, static_cast<const char *>(value));
+        else if constexpr (std::is_enum_v<T>)
+            return encode(out, at, static_cast<std::underlying_type_t<T>>(value));
+        else if constexpr (std::is_floating_point_v<T>)
+            return put(out, at, BT_F64, static_cast<double>(value));
+        else if constexpr (sizeof(T) > 4)
+            return std::is_signed_v<T> ? put(out, at, BT_I64, static_cast<std::int64_t>(value))
+                                       : put(out, at, BT_U64, static_cast<std::uint64_t>(value));
+        else
+            return std::is_signed_v<T> ? put(out, at, BT_I32, static_cast<std::int32_t>(value))
+                                       : put(out, at, BT_U32, static_cast<std::uint32_t>(value));
+    }
+}
+
+template <typename... args>
+inline void blog_emit(const blog_site *site, args... values)
+{
+    // u32 site, u32 ms, u8 payload length, payload
+    std::uint8_t record[9 + blog_max_payload];
+    const std::uint32_t id {static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(site))};
+    const std::uint32_t ms {pros::millis()};
+    std::memcpy(record, &id, 4);
+    std::memcpy(record + 4, &ms, 4);
+
+    std::size_t at {0};
+    ((at = blog_detail::encode(record + 9, at, values)), ...);
+    record[8] = static_cast<std::uint8_t>(at);
+
+    blog_write(record, 9 + at);
+}
+
+#endif
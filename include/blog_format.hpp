@@ -0,0 +1,73 @@
+//* binary log format
+
+//* headers and stuff
+#include <cstdint>
+
+#ifndef BLOG_FORMAT_HPP
+#define BLOG_FORMAT_HPP
+
+// what the binary log puts on the sd card. the robot never formats anything, a record is
+// just which log site it came from plus the raw arguments. the site (format string, file,
+// line, level, category) stays in the program image and tools/blog_decode.cpp looks it up
+// in the elf, so the elf the robot ran is the string table.
+// no pros/okapi in here so the host decoder can use it.
+
+constexpr std::uint32_t blog_magic {0x474c4242};    // "BBLG"
+constexpr std::uint16_t blog_version {1};
+
+enum blog_level : std::uint8_t
+{
+    BLOG_DEBUG,
+    BLOG_INFO,
+    BLOG_WARN,
+    BLOG_ERROR
+};
+
+/// bit index into BLOG_CATEGORIES
+enum blog_category : std::uint8_t
+{
+    BLOG_SYSTEM,
+    BLOG_AUTO,
+    BLOG_DRIVE,
+    BLOG_ODOM,
+    BLOG_SORTER,
+    BLOG_HOT_PATH
+};
+
+/// one per log site, lives in .rodata. record ids are its address.
+/// on the brain it's 12 bytes: format, file, line, level, category.
+struct blog_site
+{
+    const char *format;
+    const char *file;
+    std::uint16_t line;
+    blog_level level;
+    blog_category category;
+};
+
+static_assert(sizeof(void *) != 4 || sizeof(blog_site) == 12, "blog_site layout changed, update tools/blog_decode.cpp");
+
+/// argument tags, one byte in front of each argument
+enum blog_tag : std::uint8_t
+{
+    BT_I32 = 1,     // 4 bytes
+    BT_U32,         // 4 bytes
+    BT_I64,         // 8 bytes
+    BT_U64,         // 8 bytes
+    BT_F64,         // 8 bytes, floats get promoted like printf does
+    BT_STR          // 1 byte length, then that many bytes, no terminator
+};
+
+constexpr std::size_t blog_max_string {32};     // longer strings get cut
+constexpr std::size_t blog_max_payload {96};    // per record, arguments past this get dropped
+
+/// start of the file, followed by records:
+/// u32 site address, u32 ms, u8 payload length, payload
+struct blog_header
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t reserved;
+};
+
+#endif
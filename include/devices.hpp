@@ -0,0 +1,19 @@
+#include "main.h"
+#include "result.hpp"
+
+#ifndef DEVICES_HPP
+#define DEVICES_HPP
+
+//* checked sensor reads
+// pros hands back PROS_ERR/PROS_ERR_F and sets errno when a port is empty or holds the
+// wrong device, which is easy to miss and then gets used as a real number. these turn
+// that into a fault so the caller has to decide what to fall back on.
+
+/// imu rotation in degrees, NO_DEVICE if it's unplugged, NOT_READY while it calibrates
+result<double> imu_rotation(const pros::Imu &sensor);
+
+/// distance sensor reading in inches. OUT_OF_RANGE if there's nothing within 2 m or
+/// the confidence is under `min_confidence` (0-63).
+result<double> distance_inches(pros::Distance &sensor, std::int32_t min_confidence);
+
+#endif
@@ -0,0 +1,37 @@
+//* field geometry, change up
+
+#ifndef FIELD_HPP
+#define FIELD_HPP
+
+// everything here is in inches, origin at the red left corner, x to the right,
+// y away from the red driver station. same as okapi's CARTESIAN state mode
+// once the odom state is set to the starting tile.
+// no pros/okapi includes so the host tools can use it too.
+
+constexpr double field_size {140.5};   // inside of the perimeter
+
+enum class wall
+{
+    LEFT,   // x = 0
+    RIGHT,  // x = field_size
+    NEAR,   // y = 0
+    FAR     // y = field_size
+};
+
+/// goal centers, numbered left to right then near to far
+struct goal_pos
+{
+    double x, y;
+};
+
+constexpr double goal_inset {5.75};    // wall to goal center
+constexpr double goal_radius {5.5};    // base of the goal, what the robot can hit
+constexpr int goal_count {9};
+
+constexpr goal_pos goals[goal_count] {
+    {goal_inset, goal_inset},              {field_size / 2, goal_inset},              {field_size - goal_inset, goal_inset},
+    {goal_inset, field_size / 2},          {field_size / 2, field_size / 2},          {field_size - goal_inset, field_size / 2},
+    {goal_inset, field_size - goal_inset}, {field_size / 2, field_size - goal_inset}, {field_size - goal_inset, field_size - goal_inset}
+};
+
+#endif
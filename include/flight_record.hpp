@@ -0,0 +1,103 @@
+//* flight recorder record layout
+
+//* headers and stuff
+#include <cmath>
+#include <cstdint>
+
+#ifndef FLIGHT_RECORD_HPP
+#define FLIGHT_RECORD_HPP
+
+// what the flight recorder keeps per frame and what a dump file looks like.
+// no pros/okapi in here, tools/flight_decode.cpp reads dumps on the host.
+// both ends are little endian so the structs get written as is.
+
+constexpr std::uint32_t flight_magic {0x52464242};   // "BBFR"
+constexpr std::uint16_t flight_version {2};
+
+/// flight_record::buttons, same order as input_frame
+enum flight_button : std::uint16_t
+{
+    FB_ALIGN = 1 << 0,
+    FB_HOLD = 1 << 1,
+    FB_INDEX = 1 << 2,
+    FB_CYCLE = 1 << 3,
+    FB_SHOOT = 1 << 4,
+    FB_INTAKE = 1 << 5,
+    FB_EJECT = 1 << 6,
+    FB_CONVEY_DOWN = 1 << 7,
+    FB_ITK_FAST = 1 << 8,
+    FB_ITK_SLOW = 1 << 9
+};
+
+/// flight_record::flags
+enum flight_flag : std::uint8_t
+{
+    FF_AUTONOMOUS = 1 << 0,
+    FF_DISABLED = 1 << 1,
+    FF_FIELD = 1 << 2,      // plugged into field control
+    FF_EJECTING = 1 << 3
+};
+
+/// one 10 ms frame, 36 bytes
+struct flight_record
+{
+    std::uint32_t ms;
+    std::int16_t x;             // pose, hundredths of an inch, CARTESIAN
+    std::int16_t y;
+    std::int16_t theta;         // pose, milliradians, wrapped to +-pi
+    std::int16_t pf_x;          // particle filter estimate, same units, to check odom against
+    std::int16_t pf_y;
+    std::int16_t pf_theta;
+    std::int8_t forward;        // sticks, -127 to 127
+    std::int8_t yaw;
+    std::uint16_t buttons;      // flight_button
+    std::int16_t drive_left;    // applied mV, front motor of each side
+    std::int16_t drive_right;
+    std::int16_t intake;        // applied mV
+    std::int16_t convey_top;
+    std::int16_t convey_bot;
+    std::uint16_t battery;      // mV
+    std::uint8_t late;          // ms the recorder woke up late, cpu starvation shows up here
+    std::uint8_t flags;         // flight_flag
+    std::uint16_t spare;        // keeps the size explicit, zero
+};
+
+static_assert(sizeof(flight_record) == 36, "flight_record layout changed, bump flight_version");
+
+/// start of a dump file, followed by `count` records oldest first
+struct flight_header
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t record_size;
+    std::uint32_t count;
+    std::uint32_t dumped_ms;
+    char reason[16];
+};
+
+static_assert(sizeof(flight_header) == 32, "flight_header layout changed, bump flight_version");
+
+//* packing helpers
+
+inline std::int16_t pack_inches(double inches)
+{
+    double v {std::round(inches * 100.0)};
+    return static_cast<std::int16_t>(v > 32767.0 ? 32767.0 : v < -32768.0 ? -32768.0 : v);
+}
+
+inline std::int16_t pack_radians(double theta)
+{
+    return static_cast<std::int16_t>(std::lround(std::remainder(theta, 2.0 * M_PI) * 1000.0));
+}
+
+inline std::int8_t pack_stick(double value)
+{
+    return static_cast<std::int8_t>(std::lround((value > 1.0 ? 1.0 : value < -1.0 ? -1.0 : value) * 127.0));
+}
+
+inline std::int16_t pack_mv(std::int32_t mv)
+{
+    return static_cast<std::int16_t>(mv > 32767 ? 32767 : mv < -32768 ? -32768 : mv);
+}
+
+#endif
@@ -1,15 +1,24 @@
 #include "main.h"
+#include "robot.hpp"
+#include "standby.hpp"
 
 #ifndef GLOBALS_HPP
 #define GLOBALS_HPP
 
-extern std::shared_ptr<okapi::ChassisController> chassis;
-extern std::shared_ptr<okapi::AsyncMotionProfileController> profile_controller;
+extern std::shared_ptr<okapi::OdomChassisController> chassis;
+extern standby<okapi::AsyncMotionProfileController> profile_controller;   // parked while idle
+
+/// okapi's gearsets are their rpm
+constexpr okapi::AbstractMotor::gearset mechanism_gearset {static_cast<okapi::AbstractMotor::gearset>(mechanism_ports::rpm)};
 
 extern okapi::MotorGroup intakes;
 extern okapi::Motor convey_top;
 extern okapi::Motor convey_bot;
 extern okapi::Controller controller;
+extern okapi::Controller partner;
+
+extern pros::Imu imu;
+extern pros::Vision vision;
 
 enum class auto_select
 {
@@ -0,0 +1,37 @@
+#include "main.h"
+
+#ifndef HEAP_MONITOR_HPP
+#define HEAP_MONITOR_HPP
+
+//* heap monitor
+// samples the heap once a second: bytes in use, how much has been taken from the system,
+// and the free space at the top of the heap, which is the one block fragmentation can't
+// chop up. none of that takes the malloc lock. the real largest free block needs a probe
+// that holds the lock (stalling every task that allocates), so that only runs from
+// log_heap_high_water() while disabled.
+// the peak is sampled too, so a spike shorter than a second (generatePath's working
+// buffers) can be missed. the low free warning and the disabled probe are what catch those.
+// shown on the bottom lcd line, high water marks go to the binary log once per match.
+
+struct heap_stats
+{
+    std::uint32_t live;             // bytes in use
+    std::uint32_t peak;             // highest sampled `live` since the last log_heap_high_water()
+    std::uint32_t footprint;        // bytes taken from the system, free or not
+    std::uint32_t top_free;         // free at the top of the heap, a lower bound on the largest block
+    std::uint32_t lowest_top_free;  // smallest `top_free` since the last log_heap_high_water()
+    std::uint32_t largest_free;     // biggest malloc that worked at the last probe, to 1 KB
+};
+
+/// starts the sampling task, safe to call more than once
+void start_heap_monitor(void);
+
+/// the last sample
+heap_stats heap_now(void);
+
+/// probes the largest free block, logs it with the peak and lowest top free since the last
+/// call, then resets them. holds the malloc lock for the probe, so only call it while
+/// disabled. with ALLOC_WATCH it logs the allocation size histogram too.
+void log_heap_high_water(const char *reason);
+
+#endif
@@ -0,0 +1,76 @@
+#include "main.h"
+#include "alloc_watch.hpp"
+#include "odometry.hpp"
+
+#ifndef HOT_PATH_HPP
+#define HOT_PATH_HPP
+
+//* hot path helpers
+// control loops register themselves so debug checks know when they're inside one.
+// build with -DHOT_PATH_CHECKS (EXTRA_CXXFLAGS in the Makefile) to turn the checks on,
+// without it everything here compiles down to plain pointer access.
+// -DALLOC_WATCH also counts heap allocations per loop, see alloc_watch.hpp.
+
+/// marks the calling task as a control loop, call once at the top of the task. a task
+/// started again under the same name (opcontrol after a disable) takes over the old slot.
+void register_control_loop(const char *name);
+
+/// name of the control loop the calling task registered as, nullptr if it didn't
+const char *current_control_loop(void);
+
+/// report something a control loop shouldn't be doing, once per loop and kind
+void hot_path_warning(const char *what);
+
+/// logs how many times each control loop has allocated, and how many of those were in a
+/// realtime_region. does nothing without ALLOC_WATCH.
+void log_loop_allocations(void);
+
+/// non owning handle to something a shared_ptr owns, for things read every frame.
+/// the owner has to outlive it (e.g. the chassis owns its model); with HOT_PATH_CHECKS
+/// on it also keeps a weak_ptr and complains if the owner went away.
+template <typename T>
+class borrowed
+{
+public:
+    borrowed(void) = default;
+
+    explicit borrowed(const std::shared_ptr<T> &owner)
+        : m_ptr{owner.get()}
+#ifdef HOT_PATH_CHECKS
+        , m_check{owner}
+#endif
+    {
+
+    }
+
+    T *get(void) const
+    {
+#ifdef HOT_PATH_CHECKS
+        if (m_ptr != nullptr && m_check.expired())
+            hot_path_warning("borrowed handle outlived its owner");
+#endif
+        return m_ptr;
+    }
+
+    T *operator->(void) const { return get(); }
+    T &operator*(void) const { return *get(); }
+    explicit operator bool(void) const { return m_ptr != nullptr; }
+
+private:
+    T *m_ptr {nullptr};
+#ifdef HOT_PATH_CHECKS
+    std::weak_ptr<T> m_check;
+#endif
+};
+
+/// the chassis model, grabbed once when the chassis is built instead of copying
+/// the shared_ptr out of chassis->getModel() every frame. it's the concrete type,
+/// so calls through it skip the vtable
+extern borrowed<chassis_model> drive_model;
+
+/// owning copy of the model for code that really needs one. flagged inside control loops.
+/// it's opt in: only copies made through here get flagged, chassis->getModel() straight
+/// off the chassis isn't caught, so go through this (or drive_model) instead.
+std::shared_ptr<okapi::ChassisModel> owned_drive_model(void);
+
+#endif
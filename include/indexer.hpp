@@ -0,0 +1,31 @@
+#include "main.h"
+
+#ifndef INDEXER_HPP
+#define INDEXER_HPP
+
+//* conveyor indexing
+// moves both conveyor stages an exact distance with a linear motion profile, so one press
+// moves the balls up exactly one slot no matter how long the button is held.
+// the profiles for 1 and 2 slots are generated once in init_indexer() and reused.
+
+/// builds the profile controller and caches the index profiles, call from initialize()
+void init_indexer(void);
+
+/// moves the balls `slots` ball lengths up (or down if negative), cancelling any index
+/// that's still running. 1 and 2 slots are cached, anything else is generated on the spot.
+void index_step(int slots);
+
+/// stops an index that's running, the conveyors are free for moveVelocity again.
+/// controls task only, it parks the controller's thread.
+void index_stop(void);
+
+/// asks the controls task to stop the index on its next frame, safe from any task
+void index_cancel(void);
+
+/// true while an index profile is running, also does a pending index_cancel()
+bool indexing(void);
+
+/// how many times the index controller's thread got woken, see standby::wakeups()
+std::uint32_t index_wakeups(void);
+
+#endif
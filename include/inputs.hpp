@@ -0,0 +1,49 @@
+#include "main.h"
+
+#ifndef INPUTS_HPP
+#define INPUTS_HPP
+
+//* controller inputs
+// one task reads both controllers into a snapshot every 10 ms frame and the split decides
+// who drives and who runs the mechanisms. teleop only ever looks at snapshots, and its loops
+// wait on next_inputs() so driving() and controls() both run once per frame on the same one.
+
+enum class input_split
+{
+    MASTER_ONLY,        // one driver does everything (also what happens if the partner unplugs)
+    PARTNER_MECHANISMS, // master drives, partner runs the intake/conveyor
+    SHARED              // master drives, both can run mechanisms, partner wins if both press
+};
+
+extern input_split split;
+
+struct input_frame
+{
+    // drive, always from the drive controller
+    double forward;
+    double yaw;
+    bool align;         // A
+    bool hold_toggle;   // B
+
+    // mechanisms, from whoever the split says
+    bool index;         // R1
+    bool cycle;         // R2
+    bool shoot;         // L1
+    bool intake;        // L2
+    bool eject;         // up
+    bool convey_down;   // down
+    bool itk_fast;      // left
+    bool itk_slow;      // right
+};
+
+/// starts the task that samples the controllers, safe to call more than once
+void start_inputs(void);
+
+/// the latest snapshot, doesn't wait
+input_frame read_inputs(void);
+
+/// waits for a snapshot newer than `seen` (start it at 0) and updates `seen`. loops that
+/// pace themselves on this get the same snapshot each frame, and never one twice.
+input_frame next_inputs(std::uint32_t &seen);
+
+#endif
@@ -0,0 +1,20 @@
+#include "main.h"
+#include "particle_filter.hpp"
+
+#ifndef LOCALIZATION_HPP
+#define LOCALIZATION_HPP
+
+//* particle filter localization
+// fuses the odom deltas, imu heading, distance sensors and the vision sensor's view of
+// the goals. the filter itself is in particle_filter.hpp, this is just the robot side.
+
+constexpr std::uint32_t goal_sig {1};   // vision signature for the goals
+
+/// starts the localization task with the particles around `start` (inches, radians).
+/// the odom chassis has to be built already.
+void start_localize(const pf_pose &start);
+
+/// latest estimate, inches and radians. the flight recorder logs it next to odom.
+pf_pose localize_pose(void);
+
+#endif
@@ -0,0 +1,27 @@
+#include "main.h"
+
+#ifndef MOTOR_TUNING_HPP
+#define MOTOR_TUNING_HPP
+
+//* mechanism motor velocity pid tuning
+// the intakes and conveyors run on the motor's own velocity loop. this measures each
+// motor's step response (with balls loaded, so do it in the pits with a full robot),
+// searches the internal velocity gains, and saves them to the sd card so initialize()
+// puts them back on every boot. it also saves step logs: an open loop voltage step
+// (step_<port>_open.csv) for tools/vel_pid_fit.cpp, and the closed loop step before and
+// after tuning. "before" is the firmware's gains only if none were loaded at boot, so
+// delete /usd/vel_pid.txt and reboot first for a firmware baseline.
+
+struct vel_gains
+{
+    double kf, kp, ki, kd;
+    double filter, limit, loopspeed;
+};
+
+/// loads saved gains off the sd card and applies them, keeps the firmware's if there aren't any
+void load_vel_gains(void);
+
+/// tunes every mechanism motor one at a time and saves the result. takes a couple minutes.
+void tune_mechanisms(void);
+
+#endif
@@ -0,0 +1,36 @@
+#include "main.h"
+#include "robot.hpp"
+#include "result.hpp"
+#include "skid_steer.hpp"
+#include "tracking.hpp"
+
+#ifndef ODOMETRY_HPP
+#define ODOMETRY_HPP
+
+//* tracking wheel geometry
+// fixed geometry is in robot.hpp (tracking_layout), except the middle offset which
+// gets calibrated (see calibrate_middle_offset)
+
+extern okapi::QLength middle_offset;               // center of rotation to perpendicular wheel
+
+/// the drive model build_chassis() puts in the chassis
+using chassis_model = skid_steer_model<drivetrain, tracking_wheels>;
+
+//* functions
+
+/// odom scales for the three tracking wheels, using the current middle_offset
+okapi::ChassisScales odom_scales(void);
+
+/// builds the chassis with three wheel odometry, used by initialize()
+std::shared_ptr<okapi::OdomChassisController> build_chassis(void);
+
+/// spins the robot in place `turns` times (measured by the parallel wheels) and works out
+/// how far the perpendicular wheel sits from the center of rotation. saves it to the sd card
+/// and hands it to the running odometry. needs the robot enabled, so do it in the pits.
+/// TIMED_OUT (and the old offset kept) if it doesn't get round in time, e.g. disabled or stuck.
+result<okapi::QLength> calibrate_middle_offset(int turns = 5);
+
+/// reads a saved middle offset off the sd card, keeps the default if there isn't one
+void load_middle_offset(void);
+
+#endif
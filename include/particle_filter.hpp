@@ -0,0 +1,72 @@
+//* monte carlo localization
+
+//* headers and stuff
+#include <cstdint>
+
+#ifndef PARTICLE_FILTER_HPP
+#define PARTICLE_FILTER_HPP
+
+// no pros/okapi in here, the host sim (tools/localization_sim.cpp) builds it as is.
+// units are inches and radians, theta clockwise from +y like okapi's CARTESIAN mode.
+
+struct pf_pose
+{
+    double x, y, theta;
+};
+
+/// a sensor on the robot, x right / y forward of the tracking center, angle clockwise from forward
+struct pf_mount
+{
+    double x, y, angle;
+};
+
+/// particle filter over the field. particles are stored as separate float arrays so the
+/// weighting loops run four particles at a time with neon on the brain.
+/// weights are kept as log weights, observations just add to them, resample() normalizes.
+class particle_filter
+{
+public:
+    static constexpr int capacity {256};    // keep it a multiple of 4
+
+    explicit particle_filter(std::uint32_t seed = 0x1104a);
+
+    /// scatter all particles around a pose
+    void init(const pf_pose &pose, double spread_xy, double spread_theta);
+
+    /// move every particle by an odometry delta in the robot frame (forward, strafe right, turn)
+    void predict(double forward, double strafe, double dtheta, double noise_xy, double noise_theta);
+
+    /// absolute heading, e.g. from the imu
+    void observe_heading(double theta, double sigma);
+
+    /// distance sensor reading against the field walls. short readings (something in the way)
+    /// are only penalized up to 3 sigma.
+    void observe_distance(const pf_mount &mount, double measured, double sigma);
+
+    /// bearing to some goal seen by the vision sensor, clockwise from the camera's forward
+    void observe_goal(const pf_mount &camera, double bearing, double sigma);
+
+    /// low variance resampling, resets the log weights
+    void resample(void);
+
+    /// effective sample size, resample when it drops below about half the particles
+    double effective_size(void) const;
+
+    pf_pose estimate(void) const;
+
+private:
+    void normalize(float *weights) const;
+    float gaussian(void);
+    float uniform(void);
+
+    alignas(16) float m_x[capacity];
+    alignas(16) float m_y[capacity];
+    alignas(16) float m_theta[capacity];
+    alignas(16) float m_cos[capacity];  // cached cos/sin of theta, updated in predict()
+    alignas(16) float m_sin[capacity];
+    alignas(16) float m_lw[capacity];   // log weights
+
+    std::uint32_t m_rng;
+};
+
+#endif
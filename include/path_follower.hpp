@@ -0,0 +1,51 @@
+//* path follower stuff
+
+//* headers and stuff
+#include <cstddef>
+#include <vector>
+
+#include "okapi/pathfinder/include/pathfinder/structs.h"
+
+#ifndef PATH_FOLLOWER_HPP
+#define PATH_FOLLOWER_HPP
+
+/// nearest point + lookahead lookup over a pathfinder segment array.
+/// keeps a forward-only cursor and only searches a small window around it,
+/// so a lookup costs the same on a 2000 segment skills path as on a 50 segment one.
+class path_follower
+{
+public:
+    /// segments aren't copied, they have to outlive the follower.
+    /// window is how far ahead of the cursor we look, backtrack is how far behind.
+    path_follower(const Segment *segments, std::size_t length, std::size_t window = 16, std::size_t backtrack = 4);
+
+    /// index of the segment closest to (x, y). advances the cursor.
+    std::size_t closest(double x, double y);
+
+    /// point on the path `distance` ahead (along the path) of the closest point.
+    /// call closest() first in the same tick.
+    Coord lookahead(double distance);
+
+    /// distance along the path of a segment, from the precomputed table
+    double arc_length(std::size_t index) const { return m_arc[index]; }
+    double total_length(void) const { return m_arc.empty() ? 0.0 : m_arc.back(); }
+
+    std::size_t cursor(void) const { return m_cursor; }
+    bool finished(void) const { return m_length == 0 || m_cursor + 1 >= m_length; }
+    void reset(void);
+
+private:
+    double dist_sq(std::size_t index, double x, double y) const;
+
+    const Segment *m_segments;
+    std::size_t m_length;
+    std::size_t m_window;
+    std::size_t m_backtrack;
+
+    std::vector<double> m_arc;  // cumulative arc length per segment
+    std::size_t m_cursor {0};   // never moves backwards
+    std::size_t m_nearest {0};  // last closest() result, may sit behind the cursor
+    std::size_t m_ahead {0};    // lookahead cursor, also forward-only
+};
+
+#endif
@@ -0,0 +1,50 @@
+//* field path planner
+
+//* headers and stuff
+#include "field.hpp"
+
+#ifndef PLANNER_HPP
+#define PLANNER_HPP
+
+// no pros/okapi in here either, the host tools use it.
+// inches, same field frame as field.hpp.
+
+struct plan_point
+{
+    double x, y;
+};
+
+/// shortest route around the goals. each goal gets a ring of nodes just outside it
+/// (goal + robot footprint + margin), and which nodes can see each other is worked
+/// out once in the constructor. a query only connects the start and end to the graph
+/// and runs A* over ~70 nodes.
+class field_planner
+{
+public:
+    static constexpr int sides {8};    // nodes per goal
+    static constexpr int node_count {goal_count * sides};
+    static constexpr int max_route {node_count + 2};
+
+    /// footprint is the robot's outline in inches, margin is extra room around the goals
+    field_planner(double robot_width, double robot_length, double margin = 1.0);
+
+    /// writes the route (start and end included) to out, returns how many points,
+    /// or 0 if there's no way through. out needs room for max_route points.
+    int plan(const plan_point &start, const plan_point &end, plan_point *out) const;
+
+    double clearance(void) const { return m_clearance; }
+
+private:
+    /// true if the robot can drive straight from a to b. goals containing a or b are
+    /// ignored so routes can start and end right at a goal.
+    bool clear(const plan_point &a, const plan_point &b) const;
+    bool in_bounds(const plan_point &p) const;
+
+    double m_robot_radius;
+    double m_clearance;    // goal center to robot center
+    plan_point m_nodes[node_count];
+    bool m_usable[node_count];
+    bool m_visible[node_count][node_count];
+};
+
+#endif
@@ -0,0 +1,18 @@
+#include "main.h"
+
+#ifndef RECORDER_HPP
+#define RECORDER_HPP
+
+//* flight recorder
+// the last ~20 s of robot state (inputs, motor voltages, pose, timing) kept in a ram ring,
+// one record per 10 ms. nothing touches the sd card until a dump, so it can stay on all
+// the time. dumps land in /usd/flight_<n>.bin, decode with tools/flight_decode.cpp.
+
+/// starts the recording task and the crash hook, safe to call more than once
+void start_recorder(void);
+
+/// writes the ring to the sd card, returns false if there's no card or nothing new to write.
+/// `reason` ends up in the file header (first 15 characters).
+bool dump_recorder(const char *reason);
+
+#endif
@@ -0,0 +1,34 @@
+#include "main.h"
+
+#ifndef RELOCALIZE_HPP
+#define RELOCALIZE_HPP
+
+//* distance sensor wall relocalization
+// every so often a distance sensor reading is checked against where the wall should
+// be from the current odom pose. if a few readings in a row agree with it, the pose is
+// nudged towards what the sensor says, capped per update so a bad reading can't throw it.
+
+/// where a distance sensor sits on the robot, inches and degrees.
+/// x right, y forward from the tracking center, angle clockwise from forward.
+struct distance_mount
+{
+    std::uint8_t port;
+    double x;
+    double y;
+    double angle;
+};
+
+/// the distance sensors, also used by the particle filter
+constexpr std::size_t distance_count {2};
+extern const std::array<distance_mount, distance_count> distance_mounts;
+
+/// starts the low priority relocalization task, safe to call more than once
+void start_relocalize(void);
+
+/// turns corrections on/off, e.g. off while shoved against a goal
+void set_relocalize(bool enabled);
+
+/// total correction applied so far, inches, for tuning
+double relocalize_total(void);
+
+#endif
@@ -0,0 +1,86 @@
+//* error results
+
+//* headers and stuff
+#include <cstdint>
+#include <utility>
+
+#ifndef RESULT_HPP
+#define RESULT_HPP
+
+// what can go wrong, returned instead of thrown. nothing in our code throws, so it
+// builds with -fno-exceptions (make NO_EXCEPTIONS=1).
+// no pros/okapi in here so the host tools can use it too.
+
+enum class fault : std::uint8_t
+{
+    NONE,
+    TOO_FEW_POINTS,     // a path needs 2 or more
+    TOO_MANY_POINTS,    // generate_path() unpacks up to 6
+    POINTS_TOO_CLOSE,   // pathfinder can't fit a spline between them
+    IMPOSSIBLE_PATH,    // pathfinder gave up anyway
+    NO_FILE,            // not on the sd card (or no card)
+    NOT_LOADED,         // the file was there but the controller didn't take it
+    NO_DEVICE,          // nothing plugged in on that port, or the wrong kind of device
+    NOT_READY,          // device is there but still calibrating
+    OUT_OF_RANGE,       // device reading we can't trust
+    TIMED_OUT           // waited for something that never happened
+};
+
+/// short name for the lcd and logs
+constexpr const char *fault_name(fault f)
+{
+    switch (f)
+    {
+        case fault::NONE: return "ok";
+        case fault::TOO_FEW_POINTS: return "too few points";
+        case fault::TOO_MANY_POINTS: return "too many points";
+        case fault::POINTS_TOO_CLOSE: return "points too close";
+        case fault::IMPOSSIBLE_PATH: return "impossible path";
+        case fault::NO_FILE: return "no file";
+        case fault::NOT_LOADED: return "not loaded";
+        case fault::NO_DEVICE: return "no device";
+        case fault::NOT_READY: return "not ready";
+        case fault::OUT_OF_RANGE: return "out of range";
+        case fault::TIMED_OUT: return "timed out";
+    }
+    return "?";
+}
+
+/// a value or the fault that stopped us getting one
+template <typename T = void>
+class result
+{
+public:
+    result(T value) : m_value{std::move(value)} {}
+    result(fault error) : m_value{}, m_error{error} {}
+
+    explicit operator bool(void) const { return m_error == fault::NONE; }
+    fault error(void) const { return m_error; }
+
+    /// only meaningful if it's ok
+    const T &value(void) const { return m_value; }
+
+    /// the value, or `fallback` if there isn't one
+    T value_or(T fallback) const { return m_error == fault::NONE ? m_value : fallback; }
+
+private:
+    T m_value;
+    fault m_error {fault::NONE};
+};
+
+/// nothing to hand back, just whether it worked
+template <>
+class result<void>
+{
+public:
+    result(void) = default;
+    result(fault error) : m_error{error} {}
+
+    explicit operator bool(void) const { return m_error == fault::NONE; }
+    fault error(void) const { return m_error; }
+
+private:
+    fault m_error {fault::NONE};
+};
+
+#endif
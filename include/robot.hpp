@@ -0,0 +1,154 @@
+//* robot description, change when the robot does
+
+//* headers and stuff
+#include "tracking_math.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef ROBOT_HPP
+#define ROBOT_HPP
+
+// everything about the robot that's fixed at build time, so conversions come out as
+// constants instead of being worked out at runtime. lengths in inches, smart ports are
+// signed like okapi's (negative means reversed). the checks at the bottom turn a wrong
+// port, a port used twice or a bad ratio into a build error instead of a match problem.
+// no pros/okapi includes so the host tools can use it too.
+
+constexpr double pi {3.14159265358979323846};
+
+constexpr std::uint8_t smart_port(std::int8_t port)
+{
+    return static_cast<std::uint8_t>(port < 0 ? -port : port);
+}
+
+constexpr bool is_reversed(std::int8_t port)
+{
+    return port < 0;
+}
+
+/// internal encoder ticks per motor turn, by cartridge rpm
+constexpr double motor_tpr(int rpm)
+{
+    return rpm == 100 ? 1800.0 : rpm == 200 ? 900.0 : 300.0;
+}
+
+/// two wire adi encoder, top port has to be A, C, E or G and bottom the one after it
+struct adi_encoder_ports
+{
+    std::uint8_t top;       // 'A' to 'H'
+    std::uint8_t bottom;
+    bool reversed;
+};
+
+/// drive motors and wheels
+struct drivetrain
+{
+    static constexpr std::size_t count {2};
+    static constexpr std::array<std::int8_t, count> left {19, 20};
+    static constexpr std::array<std::int8_t, count> right {-9, -10};
+    static constexpr int rpm {200};                         // green cartridges
+    static constexpr double wheel_diameter {4.0};
+    static constexpr double track {12.0};
+    static constexpr double motor_per_wheel {4.0 / 3.0};    // motor turns per wheel turn
+
+    static constexpr double tpr {motor_tpr(rpm) * motor_per_wheel};  // motor ticks per wheel turn
+};
+
+/// the three tracking wheels
+struct tracking_layout
+{
+    static constexpr adi_encoder_ports left {'E', 'F', false};
+    static constexpr adi_encoder_ports right {'A', 'B', true};
+    static constexpr adi_encoder_ports middle {'C', 'D', false};
+    static constexpr double tpr {360.0};                // quad encoder
+    static constexpr double diameter {4.0};             // parallel wheels
+    static constexpr double track {12.0};               // left to right, center to center
+    static constexpr double middle_diameter {4.0};      // perpendicular wheel
+    static constexpr double middle_offset {6.0};        // default, calibrate_middle_offset() measures it
+
+    /// what tracking_odometry steps with, the middle offset gets swapped for the calibrated one
+    static constexpr tracking_scales scales {make_tracking_scales(diameter, middle_diameter, tpr, track, middle_offset)};
+};
+
+/// intake and conveyor motors
+struct mechanism_ports
+{
+    static constexpr std::array<std::int8_t, 2> intakes {17, -7};
+    static constexpr std::int8_t convey_top {-8};
+    static constexpr std::int8_t convey_bot {-15};
+    static constexpr int rpm {600};                     // blue cartridges
+};
+
+/// everything else on a smart port
+struct sensor_ports
+{
+    static constexpr std::uint8_t imu {5};
+    static constexpr std::uint8_t vision {6};
+    static constexpr std::uint8_t optical {11};
+    static constexpr std::array<std::uint8_t, 2> distance {3, 4};  // left side, back
+};
+
+//* build time checks
+
+namespace robot_checks
+{
+    constexpr std::array<int, 13> smart_ports {
+        drivetrain::left[0], drivetrain::left[1], drivetrain::right[0], drivetrain::right[1],
+        mechanism_ports::intakes[0], mechanism_ports::intakes[1], mechanism_ports::convey_top, mechanism_ports::convey_bot,
+        sensor_ports::imu, sensor_ports::vision, sensor_ports::optical, sensor_ports::distance[0], sensor_ports::distance[1]
+    };
+
+    constexpr bool ports_valid(void)
+    {
+        for (int p : smart_ports)
+            if (p == 0 || p < -21 || p > 21)
+                return false;
+        return true;
+    }
+
+    constexpr bool ports_unique(void)
+    {
+        bool used[22] {};
+        for (int p : smart_ports)
+        {
+            if (used[p < 0 ? -p : p])
+                return false;
+            used[p < 0 ? -p : p] = true;
+        }
+        return true;
+    }
+
+    constexpr bool encoder_valid(adi_encoder_ports e)
+    {
+        return (e.top == 'A' || e.top == 'C' || e.top == 'E' || e.top == 'G') && e.bottom == e.top + 1;
+    }
+
+    constexpr bool encoders_unique(void)
+    {
+        return tracking_layout::left.top != tracking_layout::right.top
+            && tracking_layout::left.top != tracking_layout::middle.top
+            && tracking_layout::right.top != tracking_layout::middle.top;
+    }
+
+    constexpr bool cartridge(int rpm)
+    {
+        return rpm == 100 || rpm == 200 || rpm == 600;
+    }
+}
+
+static_assert(drivetrain::count * 2 + mechanism_ports::intakes.size() + 2 + 3 + sensor_ports::distance.size()
+              == robot_checks::smart_ports.size(),
+              "robot_checks doesn't list every port, add the new one");
+static_assert(robot_checks::ports_valid(), "smart ports are 1 to 21");
+static_assert(robot_checks::ports_unique(), "two devices on the same smart port");
+static_assert(robot_checks::encoder_valid(tracking_layout::left)
+              && robot_checks::encoder_valid(tracking_layout::right)
+              && robot_checks::encoder_valid(tracking_layout::middle), "adi encoders go on A/B, C/D, E/F or G/H");
+static_assert(robot_checks::encoders_unique(), "two encoders on the same adi ports");
+static_assert(robot_checks::cartridge(drivetrain::rpm) && robot_checks::cartridge(mechanism_ports::rpm), "cartridges are 100, 200 or 600 rpm");
+static_assert(drivetrain::motor_per_wheel > 0.0 && drivetrain::wheel_diameter > 0.0 && drivetrain::track > 0.0, "bad drive geometry");
+static_assert(tracking_layout::diameter > 0.0 && tracking_layout::middle_diameter > 0.0 && tracking_layout::track > 0.0, "bad tracking wheel geometry");
+
+#endif
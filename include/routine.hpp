@@ -0,0 +1,71 @@
+#include "main.h"
+#include "particle_filter.hpp"
+#include "planner.hpp"
+#include "result.hpp"
+
+#ifndef ROUTINE_HPP
+#define ROUTINE_HPP
+
+//* autonomous routines
+// routines are written once for the red side. build_routines() mirrors them for blue
+// (paths, turns and goal ids) and generates every path for both during init, so picking
+// an alliance in autonomous is just picking which list to run.
+
+enum class alliance
+{
+    RED,
+    BLUE
+};
+
+extern alliance sel_alliance;
+
+// PathfinderPoints are start relative: x forward, y to the left, theta counterclockwise.
+// that's pathfinder's tank modifier (left wheel on the +y side), not okapi's odom frame.
+
+enum class step_kind
+{
+    PATH,   // follow points, start relative like generatePath
+    ROUTE,  // plan around the goals to a field pose and follow it, generated when it runs
+    TURN,   // turn in place
+    MECH,   // run the conveyor/intake for a while
+    SCORE   // same as MECH, but at a goal (goal id gets mirrored too)
+};
+
+struct auto_step
+{
+    step_kind kind;
+    std::vector<okapi::PathfinderPoint> points;
+    bool backwards;
+    okapi::QAngle angle;
+    int bot, top, itk;
+    int ms;
+    int goal;
+    std::string path_id;    // filled in by build_routines()
+    pf_pose target;         // ROUTE, field inches and radians clockwise from +y
+};
+
+/// generatePath for a runtime list of 2-6 points, since it only takes an initializer_list.
+/// checks the points first so a bad path comes back as a fault instead of an okapi throw.
+result<> generate_path(const okapi::PathfinderPoint *points, std::size_t count, const std::string &id);
+
+/// plans a route from the localization estimate to `end` (field inches) around the goals
+/// and generates it as `id`. IMPOSSIBLE_PATH if the planner can't find a way around.
+result<> route_to(const plan_point &end, okapi::QAngle end_heading, const std::string &id);
+
+/// loadPath, but checks the csvs are on the card and that the controller actually took it
+result<> load_path(const std::string &directory, const std::string &id);
+
+/// where the routines start on the field (field.hpp frame, inches, radians clockwise from +y).
+/// red's is measured, blue's is red's mirrored onto the far wall.
+pf_pose start_pose(alliance side);
+
+/// builds the profile controller, mirrors every routine and generates all the paths
+void build_routines(void);
+
+/// runs the conveyor stages and intakes at these rpms for `ms`, then stops them
+void run_mechanisms(int bot, int top, int itk, int ms);
+
+/// runs the live routine for sel_alliance
+void run_live(void);
+
+#endif
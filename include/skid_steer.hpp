@@ -0,0 +1,244 @@
+//* devirtualized skid steer model
+
+//* headers and stuff
+#include "okapi/api/chassis/model/chassisModel.hpp"
+#include "pros/motors.h"
+#include "robot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+#ifndef SKID_STEER_HPP
+#define SKID_STEER_HPP
+
+// okapi's SkidSteerModel drives two MotorGroups through AbstractMotor, so one arcade() goes
+// model -> group -> motor -> pros::Motor, virtual at every hop. skid_steer_model is final and
+// templated on the drivetrain, so the port loops unroll and each command ends up as a couple
+// of pros::c::motor_move_* calls. it still is an okapi::ChassisModel, so the chassis and
+// profile controllers take it like any other model.
+// no main.h in here, tools/drive_model_bench.cpp builds it on the host with a fake motor_io.
+
+/// straight pros c api calls
+struct pros_motor_io
+{
+    static void velocity(std::uint8_t port, std::int32_t rpm) { pros::c::motor_move_velocity(port, rpm); }
+    static void voltage(std::uint8_t port, std::int32_t mv) { pros::c::motor_move_voltage(port, mv); }
+    static void reversed(std::uint8_t port, bool reverse) { pros::c::motor_set_reversed(port, reverse); }
+
+    static void gearing(std::uint8_t port, okapi::AbstractMotor::gearset gearset)
+    {
+        switch (gearset)
+        {
+            case okapi::AbstractMotor::gearset::red: pros::c::motor_set_gearing(port, pros::E_MOTOR_GEARSET_36); break;
+            case okapi::AbstractMotor::gearset::blue: pros::c::motor_set_gearing(port, pros::E_MOTOR_GEARSET_06); break;
+            default: pros::c::motor_set_gearing(port, pros::E_MOTOR_GEARSET_18); break;
+        }
+    }
+
+    // okapi's brake modes and encoder units have the same values as the pros ones
+    static void brake(std::uint8_t port, okapi::AbstractMotor::brakeMode mode)
+    {
+        pros::c::motor_set_brake_mode(port, static_cast<pros::motor_brake_mode_e_t>(mode));
+    }
+
+    static void units(std::uint8_t port, okapi::AbstractMotor::encoderUnits units)
+    {
+        pros::c::motor_set_encoder_units(port, static_cast<pros::motor_encoder_units_e_t>(units));
+    }
+};
+
+/// skid steer model for one exact drivetrain (see robot.hpp). `sensors` needs getSensorVals()
+/// and reset(), and the commands behave the same as okapi's SkidSteerModel.
+template <typename drive, typename sensors, typename io = pros_motor_io>
+class skid_steer_model final : public okapi::ChassisModel
+{
+public:
+    static_assert(drive::count > 0, "drivetrain needs motors");
+
+    explicit skid_steer_model(std::shared_ptr<sensors> wheels)
+        : m_wheels{std::move(wheels)}
+    {
+        // reversal goes into the motor once, same as okapi::Motor does, so it agrees with any
+        // okapi::Motor on the same port and the commands below go through untouched
+        for (std::size_t i = 0; i < drive::count; ++i)
+        {
+            io::reversed(smart_port(drive::left[i]), is_reversed(drive::left[i]));
+            io::reversed(smart_port(drive::right[i]), is_reversed(drive::right[i]));
+        }
+        setGearing(static_cast<okapi::AbstractMotor::gearset>(drive::rpm));   // okapi's gearsets are their rpm
+    }
+
+    void forward(double speed) override
+    {
+        const double out {std::clamp(speed, -1.0, 1.0) * m_max_velocity};
+        velocity(out, out);
+    }
+
+    void driveVector(double forward_speed, double yaw) override
+    {
+        double left {0.0}, right {0.0};
+        vector(forward_speed, yaw, left, right);
+        velocity(left * m_max_velocity, right * m_max_velocity);
+    }
+
+    void driveVectorVoltage(double forward_speed, double yaw) override
+    {
+        double left {0.0}, right {0.0};
+        vector(forward_speed, yaw, left, right);
+        voltage(left * m_max_voltage, right * m_max_voltage);
+    }
+
+    void rotate(double speed) override
+    {
+        const double out {std::clamp(speed, -1.0, 1.0) * m_max_velocity};
+        velocity(out, -out);
+    }
+
+    void stop(void) override
+    {
+        velocity(0.0, 0.0);
+    }
+
+    void tank(double left_speed, double right_speed, double threshold = 0) override
+    {
+        voltage(deadband(left_speed, threshold) * m_max_voltage, deadband(right_speed, threshold) * m_max_voltage);
+    }
+
+    void arcade(double forward_speed, double yaw, double threshold = 0) override
+    {
+        forward_speed = deadband(forward_speed, threshold);
+        yaw = deadband(yaw, threshold);
+
+        // okapi's arcade mixing, the faster side gets the larger input
+        const double max_input {std::copysign(std::max(std::abs(forward_speed), std::abs(yaw)), forward_speed)};
+        double left {forward_speed + yaw}, right {forward_speed - yaw};
+        if ((forward_speed >= 0.0) == (yaw >= 0.0))
+            left = max_input;
+        else
+            right = max_input;
+
+        voltage(std::clamp(left, -1.0, 1.0) * m_max_voltage, std::clamp(right, -1.0, 1.0) * m_max_voltage);
+    }
+
+    void left(double speed) override
+    {
+        const std::int32_t out {static_cast<std::int32_t>(std::clamp(speed, -1.0, 1.0) * m_max_velocity)};
+        for (std::size_t i = 0; i < drive::count; ++i)
+            io::velocity(smart_port(drive::left[i]), out);
+    }
+
+    void right(double speed) override
+    {
+        const std::int32_t out {static_cast<std::int32_t>(std::clamp(speed, -1.0, 1.0) * m_max_velocity)};
+        for (std::size_t i = 0; i < drive::count; ++i)
+            io::velocity(smart_port(drive::right[i]), out);
+    }
+
+    std::valarray<std::int32_t> getSensorVals(void) const override
+    {
+        return m_wheels->getSensorVals();
+    }
+
+    void resetSensors(void) override
+    {
+        m_wheels->reset();
+    }
+
+    void setBrakeMode(okapi::AbstractMotor::brakeMode mode) override
+    {
+        for (std::size_t i = 0; i < drive::count; ++i)
+        {
+            io::brake(smart_port(drive::left[i]), mode);
+            io::brake(smart_port(drive::right[i]), mode);
+        }
+    }
+
+    void setEncoderUnits(okapi::AbstractMotor::encoderUnits units) override
+    {
+        for (std::size_t i = 0; i < drive::count; ++i)
+        {
+            io::units(smart_port(drive::left[i]), units);
+            io::units(smart_port(drive::right[i]), units);
+        }
+    }
+
+    void setGearing(okapi::AbstractMotor::gearset gearset) override
+    {
+        for (std::size_t i = 0; i < drive::count; ++i)
+        {
+            io::gearing(smart_port(drive::left[i]), gearset);
+            io::gearing(smart_port(drive::right[i]), gearset);
+        }
+    }
+
+    void setMaxVelocity(double max_velocity) override
+    {
+        m_max_velocity = std::max(max_velocity, 0.0);
+    }
+
+    double getMaxVelocity(void) const override
+    {
+        return m_max_velocity;
+    }
+
+    void setMaxVoltage(double max_voltage) override
+    {
+        m_max_voltage = std::clamp(max_voltage, 0.0, 12000.0);
+    }
+
+    double getMaxVoltage(void) const override
+    {
+        return m_max_voltage;
+    }
+
+private:
+    std::shared_ptr<sensors> m_wheels;
+    double m_max_velocity {static_cast<double>(drive::rpm)};
+    double m_max_voltage {12000.0};
+
+    static double deadband(double value, double threshold)
+    {
+        value = std::clamp(value, -1.0, 1.0);
+        return std::abs(value) < threshold ? 0.0 : value;
+    }
+
+    /// okapi's (wpilib's) driveVector mixing, scaled back into [-1, 1]
+    static void vector(double forward_speed, double yaw, double &left, double &right)
+    {
+        forward_speed = std::clamp(forward_speed, -1.0, 1.0);
+        yaw = std::clamp(yaw, -1.0, 1.0);
+        left = forward_speed + yaw;
+        right = forward_speed - yaw;
+
+        const double max_mag {std::max(std::abs(left), std::abs(right))};
+        if (max_mag > 1.0)
+        {
+            left /= max_mag;
+            right /= max_mag;
+        }
+    }
+
+    void velocity(double left, double right)
+    {
+        for (std::size_t i = 0; i < drive::count; ++i)
+        {
+            io::velocity(smart_port(drive::left[i]), static_cast<std::int32_t>(left));
+            io::velocity(smart_port(drive::right[i]), static_cast<std::int32_t>(right));
+        }
+    }
+
+    void voltage(double left, double right)
+    {
+        for (std::size_t i = 0; i < drive::count; ++i)
+        {
+            io::voltage(smart_port(drive::left[i]), static_cast<std::int32_t>(left));
+            io::voltage(smart_port(drive::right[i]), static_cast<std::int32_t>(right));
+        }
+    }
+};
+
+#endif
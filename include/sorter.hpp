@@ -0,0 +1,27 @@
+#include "main.h"
+#include "ball_tracker.hpp"
+
+#ifndef SORTER_HPP
+#define SORTER_HPP
+
+//* ball color sorting
+// the optical sensor at the bottom of the conveyor sees each ball go past and hands it to
+// the ball tracker. wrong colored balls get thrown out by reversing convey_top once the
+// tracker says they've reached it. positions come from the conveyor encoders, not delays,
+// so it doesn't care how fast we're cycling.
+
+extern ball_color our_color;
+
+/// starts the sorting task, safe to call more than once
+void start_sorter(void);
+
+/// on by default, the driver can turn it off if the sensor acts up
+void set_sorter(bool enabled);
+
+/// true while an eject is running and the sorter owns convey_top
+bool sorter_ejecting(void);
+
+/// copy of where every ball is right now, updated every 5 ms
+ball_tracker tracked_balls(void);
+
+#endif
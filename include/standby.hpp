@@ -0,0 +1,98 @@
+#include "main.h"
+
+#ifndef STANDBY_HPP
+#define STANDBY_HPP
+
+//* parking idle okapi controller threads
+// okapi's async motion profile controllers keep their thread waking up every 10 ms to
+// check for a path, even in teleop when nothing is running. the loop is inside the prebuilt
+// library so it can't wait on a notification itself. standby suspends the thread once the
+// controller is settled and resumes it before anything touches the controller again,
+// so a parked controller costs nothing.
+// park only from the task that commands the controller, so a park can't land between
+// another task's wake and its setTarget.
+
+template <typename controller>
+class standby
+{
+public:
+    standby(void) = default;
+
+    /// takes over a built controller (thread already started) and parks it
+    explicit standby(std::shared_ptr<controller> owner)
+        : m_controller{std::move(owner)}, m_task{m_controller->getThread()->thread}
+    {
+        park();
+    }
+
+    /// wakes the thread if it's parked and hands over the controller, use it for anything that
+    /// starts motion (setTarget, flipDisable(false))
+    controller *operator->(void)
+    {
+        wake();
+        return m_controller.get();
+    }
+
+    /// the controller without waking it, for calls that don't start motion
+    /// (generatePath, loadPath, removePath, getPaths, flipDisable(true))
+    controller *get(void) const
+    {
+        return m_controller.get();
+    }
+
+    explicit operator bool(void) const
+    {
+        return m_controller != nullptr;
+    }
+
+    /// parks the thread if there's nothing left to run, true if the controller is settled
+    bool settle(void)
+    {
+        if (!m_controller->isSettled())
+            return false;
+
+        park();
+        return true;
+    }
+
+    /// waitUntilSettled(), then parks
+    void wait(void)
+    {
+        wake();
+        m_controller->waitUntilSettled();
+        park();
+    }
+
+    /// how many times the thread got woken back up, for checking nothing wakes it in teleop
+    std::uint32_t wakeups(void) const
+    {
+        return m_wakeups;
+    }
+
+private:
+    std::shared_ptr<controller> m_controller;
+    pros::task_t m_task {nullptr};
+    std::uint32_t m_wakeups {0};
+
+    bool parked(void) const
+    {
+        return pros::c::task_get_state(m_task) == pros::E_TASK_STATE_SUSPENDED;
+    }
+
+    void wake(void)
+    {
+        if (m_task == nullptr || !parked())
+            return;
+
+        pros::c::task_resume(m_task);
+        ++m_wakeups;
+    }
+
+    void park(void)
+    {
+        if (m_task != nullptr && !parked())
+            pros::c::task_suspend(m_task);
+    }
+};
+
+#endif
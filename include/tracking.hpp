@@ -0,0 +1,60 @@
+#include "main.h"
+#include "tracking_math.hpp"
+
+#ifndef TRACKING_HPP
+#define TRACKING_HPP
+
+//* allocation free tracking wheel odometry
+// okapi's getSensorVals() hands back a std::valarray by value and TwoEncoderOdometry keeps
+// its tick buffers as valarrays, so every 10 ms odom step mallocs and frees a few times.
+// these read straight into fixed arrays instead and plug into the chassis builder through
+// withOdometry(). getSensorVals() still works for anything that wants the okapi interface.
+
+/// the three tracking wheel encoders
+class tracking_wheels : public okapi::ReadOnlyChassisModel
+{
+public:
+    tracking_wheels(pros::ADIEncoder left, pros::ADIEncoder right, pros::ADIEncoder middle);
+
+    /// allocation free read, left/right/middle ticks
+    void read(tracking_ticks &out) const;
+
+    /// okapi interface, wraps read()
+    std::valarray<std::int32_t> getSensorVals() const override;
+
+    /// zeroes all three encoders
+    void reset(void);
+
+private:
+    pros::ADIEncoder m_left, m_right, m_middle;
+};
+
+/// three wheel odometry on top of tracking_wheels, same interface as okapi's
+class tracking_odometry : public okapi::Odometry
+{
+public:
+    tracking_odometry(std::shared_ptr<tracking_wheels> wheels, const okapi::ChassisScales &scales);
+
+    /// takes the middle offset from `scales`, the rest is tracking_layout::scales. safe while
+    /// the odom thread is running, calibrate_middle_offset() uses it
+    void setScales(const okapi::ChassisScales &scales) override;
+    void step() override;
+    okapi::OdomState getState(const okapi::StateMode &mode = okapi::StateMode::FRAME_TRANSFORMATION) const override;
+    void setState(const okapi::OdomState &state, const okapi::StateMode &mode = okapi::StateMode::FRAME_TRANSFORMATION) override;
+    std::shared_ptr<okapi::ReadOnlyChassisModel> getModel() override;
+    okapi::ChassisScales getScales() override;
+
+private:
+    std::shared_ptr<tracking_wheels> m_wheels;
+    okapi::ChassisScales m_scales;
+    tracking_scales m_tracking;
+    pros::Mutex m_scales_lock;      // m_tracking, setScales() comes from other tasks
+
+    tracking_ticks m_last {};
+    bool m_primed {false};
+    tracking_pose m_pose {0.0, 0.0, 0.0};
+
+    static constexpr std::int32_t max_tick_diff {1000};  // same glitch filter as okapi
+};
+
+#endif
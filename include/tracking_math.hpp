@@ -0,0 +1,67 @@
+//* tracking wheel odometry math
+
+//* headers and stuff
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#ifndef TRACKING_MATH_HPP
+#define TRACKING_MATH_HPP
+
+// no pros/okapi in here, tools/odom_alloc_bench.cpp builds it on the host.
+// inches and radians. x forward and y right of the start, theta clockwise
+// (okapi's FRAME_TRANSFORMATION).
+
+using tracking_ticks = std::array<std::int32_t, 3>;    // left, right, middle
+
+struct tracking_scales
+{
+    double per_tick;        // parallel wheels, inches per tick
+    double middle_per_tick; // perpendicular wheel, inches per tick
+    double track;           // left to right
+    double inv_track;       // 1 / track, so a step doesn't divide by it
+    double middle_offset;   // what calibrate_middle_offset() measures
+};
+
+/// scales from the wheel geometry, constexpr so robot.hpp's come out as constants
+constexpr tracking_scales make_tracking_scales(double diameter, double middle_diameter, double tpr, double track, double middle_offset)
+{
+    return {M_PI * diameter / tpr, M_PI * middle_diameter / tpr, track, 1.0 / track, middle_offset};
+}
+
+struct tracking_pose
+{
+    double x, y, theta;
+};
+
+/// one arc step. the robot is treated as moving on a circle over the step, the chord
+/// comes from the right and middle wheels and gets rotated by the average heading.
+inline void arc_step(const tracking_ticks &diff, const tracking_scales &s, tracking_pose &pose)
+{
+    double left {diff[0] * s.per_tick};
+    double right {diff[1] * s.per_tick};
+    double middle {diff[2] * s.middle_per_tick};
+    double dtheta {(left - right) * s.inv_track};
+
+    double forward {0.0}, strafe {0.0};
+    if (std::abs(dtheta) < 1e-9)
+    {
+        forward = (left + right) / 2.0;
+        strafe = middle;
+    }
+    else
+    {
+        double chord {2.0 * std::sin(dtheta / 2.0)};
+        double inv_dtheta {1.0 / dtheta};
+        forward = chord * (right * inv_dtheta + s.track / 2.0);
+        strafe = chord * (middle * inv_dtheta - s.middle_offset);   // a pure spin cancels out
+    }
+
+    double heading {pose.theta + dtheta / 2.0};
+    double c {std::cos(heading)}, sn {std::sin(heading)};
+    pose.x += forward * c - strafe * sn;
+    pose.y += forward * sn + strafe * c;
+    pose.theta += dtheta;
+}
+
+#endif
@@ -0,0 +1,91 @@
+//* goal auto align
+
+//* headers and stuff
+#include "globals.hpp"
+#include "align.hpp"
+#include "field.hpp"
+#include "hot_path.hpp"
+#include "localization.hpp"
+#include "main.h"
+
+#include <cmath>
+
+//* global vars
+
+static constexpr double standoff {14.0};        // goal center to robot center, inches
+static constexpr double drive_kp {0.06};        // per inch
+static constexpr double turn_kp {0.025};        // per degree
+static constexpr double vision_weight {0.7};    // how much to trust the camera's heading
+static constexpr double vision_fov {61.0};
+static constexpr double done_dist {0.75};
+static constexpr double done_angle {2.0};
+
+static int goal {-1};
+
+//* functions
+
+static double clamp(double v, double limit)
+{
+    return (v > limit) ? limit : (v < -limit) ? -limit : v;
+}
+
+static double wrap_deg(double a)
+{
+    return std::remainder(a, 360.0);
+}
+
+void align_start(void)
+{
+    goal = -1;
+}
+
+bool align_step(void)
+{
+    auto state {chassis->getState()};   // CARTESIAN, set in build_chassis()
+    double x {state.x.convert(okapi::inch)};
+    double y {state.y.convert(okapi::inch)};
+    double theta {state.theta.convert(okapi::degree)};
+
+    // pick the goal once per press so it doesn't flip between two close ones
+    if (goal == -1)
+    {
+        double best {INFINITY};
+        for (int g = 0; g < goal_count; ++g)
+        {
+            double d {std::hypot(goals[g].x - x, goals[g].y - y)};
+            if (d < best)
+            {
+                best = d;
+                goal = g;
+            }
+        }
+    }
+
+    // scoring pose: on the line from the goal to us, standoff away, facing it
+    double gx {goals[goal].x - x}, gy {goals[goal].y - y};
+    double dist {std::hypot(gx, gy)};
+    double facing {std::atan2(gx, gy) * 180.0 / M_PI};
+    double angle_error {wrap_deg(facing - theta)};
+
+    // camera sees the goal, blend its bearing in
+    pros::vision_object_s_t seen {vision.get_by_sig(0, goal_sig)};
+    if (seen.signature != VISION_OBJECT_ERR_SIG && seen.width > 10)
+    {
+        double bearing {(seen.x_middle_coord - VISION_FOV_WIDTH / 2.0) / VISION_FOV_WIDTH * vision_fov};
+        angle_error = (1.0 - vision_weight) * angle_error + vision_weight * bearing;
+    }
+
+    double dist_error {dist - standoff};
+
+    // don't drive much until we're roughly pointed at it
+    double forward {clamp(drive_kp * dist_error, 1.0) * std::max(0.0, std::cos(angle_error * M_PI / 180.0))};
+    double yaw {clamp(turn_kp * angle_error, 0.6)};
+
+    bool done {std::abs(dist_error) < done_dist && std::abs(angle_error) < done_angle};
+    if (done)
+        drive_model->stop();
+    else
+        drive_model->driveVector(forward, yaw);
+
+    return done;
+}
@@ -2,27 +2,107 @@
 
 //* headers and stuff
 #include "globals.hpp"
+#include "blog.hpp"
+#include "field.hpp"
+#include "localization.hpp"
+#include "planner.hpp"
+#include "routine.hpp"
 #include "main.h"
 
+#include <cmath>
+#include <cstdio>
+
+//* global vars
+
+static const field_planner planner {18.0, 18.0};    // robot footprint, inches
+static constexpr int skills_score_ms {1500};        // score_time in tools/skills_optimizer.cpp
+
 //* functions
-void live(void)
+
+result<> route_to(const plan_point &end, okapi::QAngle end_heading, const std::string &id)
 {
+    const pf_pose here {localize_pose()};
+    const plan_point start {here.x, here.y};
+    const double theta {here.theta};
+
+    plan_point route[field_planner::max_route];
+    int count {planner.plan(start, end, route)};
+    if (count < 2)
+        return fault::IMPOSSIBLE_PATH;
+
+    okapi::PathfinderPoint points[field_planner::max_route];
+    for (int i = 0; i < count; ++i)
+    {
+        double dx {route[i].x - start.x}, dy {route[i].y - start.y};
+
+        // heading at a corner bisects the two legs, the ends use the robot/requested heading.
+        // field headings are clockwise, pathfinder's are counterclockwise
+        double heading {0.0};
+        if (i == count - 1)
+            heading = end_heading.convert(okapi::radian) - theta;
+        else if (i > 0)
+        {
+            double in {std::atan2(route[i].x - route[i - 1].x, route[i].y - route[i - 1].y)};
+            double out {std::atan2(route[i + 1].x - route[i].x, route[i + 1].y - route[i].y)};
+            heading = std::atan2(std::sin(in) + std::sin(out), std::cos(in) + std::cos(out)) - theta;
+        }
+
+        // forward is (sin, cos) of the field heading, left is (-cos, sin)
+        points[i] = {
+            (dx * std::sin(theta) + dy * std::cos(theta)) * okapi::inch,
+            (dy * std::sin(theta) - dx * std::cos(theta)) * okapi::inch,
+            -heading * okapi::radian
+        };
+    }
+
+    return generate_path(points, count, id);
+}
 
+void live(void)
+{
+    run_live();
 }
 
+/// runs the route from tools/skills_optimizer, copied to /usd/skills
 void skills(void)
 {
+    FILE *index {std::fopen("/usd/skills/route.txt", "r")};
+    if (index == nullptr)
+    {
+        BLOG(BLOG_ERROR, BLOG_AUTO, "no skills route on the sd card");
+        return;
+    }
+
+    char id[32];
+    int goal {0};
+    while (std::fscanf(index, "%31s %d", id, &goal) == 2)
+    {
+        BLOG(BLOG_INFO, BLOG_AUTO, "skills leg %s, goal %d", id, goal);
+        result<> loaded {load_path("/usd/skills", id)};
+        if (!loaded)
+        {
+            BLOG(BLOG_ERROR, BLOG_AUTO, "skills leg %s: %s", id, fault_name(loaded.error()));
+            break;
+        }
+        profile_controller->setTarget(id);
+        profile_controller.wait();
+        profile_controller.get()->removePath(id);
+
+        // each leg ends at the goal's scoring pose, shoot for as long as the optimizer budgets
+        if (goal < 0 || goal >= goal_count)
+        {
+            BLOG(BLOG_ERROR, BLOG_AUTO, "skills leg %s: no goal %d", id, goal);
+            break;
+        }
+        run_mechanisms(600, 600, 0, skills_score_ms);
+    }
 
+    std::fclose(index);
 }
 
 /// main callback
-void autonmous(void)
+void autonomous(void)
 {
-    profile_controller = okapi::AsyncMotionProfileControllerBuilder()
-        .withLimits({1.0, 2.0, 10.0})
-        .withOutput(chassis)
-        .buildMotionProfileController();
-
     switch (sel_auto)
     {
         case auto_select::LIVE:
@@ -0,0 +1,62 @@
+//* conveyor ball tracking
+
+//* headers and stuff
+#include "ball_tracker.hpp"
+
+//* functions
+
+ball_tracker::ball_tracker(double bot_per_count, double top_per_count, double split, double exit, double fall_out)
+    : m_bot_per_count{bot_per_count}, m_top_per_count{top_per_count}, m_split{split}, m_exit{exit}, m_fall_out{fall_out}
+{
+
+}
+
+void ball_tracker::update(double bot_counts, double top_counts)
+{
+    // first reading just sets the reference
+    if (!m_primed)
+    {
+        m_last_bot = bot_counts;
+        m_last_top = top_counts;
+        m_primed = true;
+        return;
+    }
+
+    double bot {(bot_counts - m_last_bot) * m_bot_per_count};
+    double top {(top_counts - m_last_top) * m_top_per_count};
+    m_last_bot = bot_counts;
+    m_last_top = top_counts;
+
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        tracked_ball &ball {m_balls[(m_head + i) % capacity]};
+        ball.position += (ball.position < m_split) ? bot : top;
+    }
+
+    // scored off the top
+    while (m_count > 0 && m_balls[m_head].position > m_exit)
+        pop();
+
+    // spat out the bottom, that's the newest one
+    while (m_count > 0 && m_balls[(m_head + m_count - 1) % capacity].position < -m_fall_out)
+        --m_count;
+}
+
+bool ball_tracker::add(ball_color color, std::uint32_t seen_ms)
+{
+    if (m_count == capacity)
+        return false;
+
+    m_balls[(m_head + m_count) % capacity] = {0.0, color, seen_ms};
+    ++m_count;
+    return true;
+}
+
+void ball_tracker::pop(void)
+{
+    if (m_count == 0)
+        return;
+
+    m_head = (m_head + 1) % capacity;
+    --m_count;
+}
@@ -0,0 +1,104 @@
+//* deferred formatting binary log
+
+//* headers and stuff
+#include "blog.hpp"
+#include "main.h"
+
+#include <array>
+#include <cstdio>
+
+//* global vars
+
+static constexpr std::size_t buffer_size {8192};
+static constexpr int drain_ms {100};
+static constexpr int max_logs {100};
+
+static std::array<std::uint8_t, buffer_size> buffer;
+static std::size_t used {0};
+static std::uint32_t dropped {0};
+static pros::Mutex buffer_lock;
+
+//* functions
+
+void blog_write(const std::uint8_t *record, std::size_t size)
+{
+    // control loops log, so never wait on the lock, a dropped record beats a late frame
+    if (!buffer_lock.take(0))
+    {
+        ++dropped;
+        return;
+    }
+
+    if (used + size <= buffer_size)
+    {
+        std::memcpy(buffer.data() + used, record, size);
+        used += size;
+    }
+    else
+        ++dropped;
+    buffer_lock.give();
+}
+
+std::uint32_t blog_dropped(void)
+{
+    return dropped;
+}
+
+static FILE *open_log(void)
+{
+    char name[32];
+    for (int i = 0; i < max_logs; ++i)
+    {
+        std::snprintf(name, sizeof(name), "/usd/blog_%d.bin", i);
+        if (FILE *existing {std::fopen(name, "rb")})
+        {
+            std::fclose(existing);
+            continue;
+        }
+        return std::fopen(name, "wb");
+    }
+    return nullptr;
+}
+
+static void drain_loop(void)
+{
+    FILE *file {open_log()};
+    if (file == nullptr)
+    {
+        // no card, logging stays in ram and stops once the buffer's full
+        pros::lcd::print(6, "blog: no sd card, not logging");
+        return;
+    }
+
+    blog_header header {blog_magic, blog_version, 0};
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    // swap the buffer out under the lock, the sd write happens without it
+    static std::array<std::uint8_t, buffer_size> out;
+    std::uint32_t now {pros::millis()};
+    while (true)
+    {
+        pros::Task::delay_until(&now, drain_ms);
+
+        buffer_lock.take(TIMEOUT_MAX);
+        std::size_t size {used};
+        std::memcpy(out.data(), buffer.data(), size);
+        used = 0;
+        buffer_lock.give();
+
+        if (size == 0)
+            continue;
+        std::fwrite(out.data(), 1, size, file);
+        std::fflush(file);
+    }
+}
+
+void start_blog(void)
+{
+    static bool started {false};
+    if (started)
+        return;
+    started = true;
+
+    static pros::Task task {drain_loop, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "blog"};
+}
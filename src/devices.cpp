@@ -0,0 +1,33 @@
+//* checked sensor reads
+
+//* headers and stuff
+#include "devices.hpp"
+#include "main.h"
+
+#include <cerrno>
+
+//* functions
+
+result<double> imu_rotation(const pros::Imu &sensor)
+{
+    // pros says PROS_ERR_F while it calibrates too, errno tells the two apart
+    errno = 0;
+    double rotation {sensor.get_rotation()};
+    if (rotation == PROS_ERR_F)
+        return (errno == EAGAIN) ? fault::NOT_READY : fault::NO_DEVICE;
+    if (sensor.is_calibrating())
+        return fault::NOT_READY;
+    return rotation;
+}
+
+result<double> distance_inches(pros::Distance &sensor, std::int32_t min_confidence)
+{
+    std::int32_t mm {sensor.get()};
+    if (mm == PROS_ERR)
+        return fault::NO_DEVICE;
+
+    // 9999 when nothing's in view, and it gets unreliable well before that
+    if (mm <= 0 || mm >= 2000 || sensor.get_confidence() < min_confidence)
+        return fault::OUT_OF_RANGE;
+    return mm / 25.4;
+}
@@ -1,16 +1,21 @@
 #include "globals.hpp"
+#include "robot.hpp"
 
-std::shared_ptr<okapi::ChassisController> chassis;
-std::shared_ptr<okapi::AsyncMotionProfileController> profile_controller;
+std::shared_ptr<okapi::OdomChassisController> chassis;
+standby<okapi::AsyncMotionProfileController> profile_controller;
 
 okapi::MotorGroup intakes {
-    okapi::Motor{17, false, okapi::AbstractMotor::gearset::blue, okapi::AbstractMotor::encoderUnits::counts},
-    okapi::Motor{7, true, okapi::AbstractMotor::gearset::blue, okapi::AbstractMotor::encoderUnits::counts}
+    okapi::Motor{smart_port(mechanism_ports::intakes[0]), is_reversed(mechanism_ports::intakes[0]), mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts},
+    okapi::Motor{smart_port(mechanism_ports::intakes[1]), is_reversed(mechanism_ports::intakes[1]), mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts}
 };
 
-okapi::Motor convey_top {8, true, okapi::AbstractMotor::gearset::blue, okapi::AbstractMotor::encoderUnits::counts};
-okapi::Motor convey_bot {15, true, okapi::AbstractMotor::gearset::blue, okapi::AbstractMotor::encoderUnits::counts};
+okapi::Motor convey_top {smart_port(mechanism_ports::convey_top), is_reversed(mechanism_ports::convey_top), mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts};
+okapi::Motor convey_bot {smart_port(mechanism_ports::convey_bot), is_reversed(mechanism_ports::convey_bot), mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts};
 
 okapi::Controller controller {okapi::ControllerId::master};
+okapi::Controller partner {okapi::ControllerId::partner};
+
+pros::Imu imu {sensor_ports::imu};
+pros::Vision vision {sensor_ports::vision};
 
 auto_select sel_auto;
\ No newline at end of file
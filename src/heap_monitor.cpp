@@ -0,0 +1,129 @@
+//* heap monitor
+
+//* headers and stuff
+#include "alloc_watch.hpp"
+#include "blog.hpp"
+#include "heap_monitor.hpp"
+#include "main.h"
+
+#include <cstdlib>
+#include <malloc.h>
+#include <unistd.h>
+
+//* global vars
+
+static constexpr int sample_ms {1000};
+static constexpr std::uint32_t probe_step {1024};
+static constexpr std::uint32_t low_free {256u << 10};       // warn under this, generatePath wants room
+
+extern "C" char _heap_end[];     // from the linker script, where sbrk stops
+
+static heap_stats stats {};
+static pros::Mutex stats_lock;
+
+//* functions
+
+/// binary search for the biggest malloc that works, never more than the free space there
+/// is. holds newlib's malloc lock (it's recursive) so another task can't allocate, and fail,
+/// while the probe has most of the heap.
+static std::uint32_t probe_largest_free(std::uint32_t free_bytes)
+{
+    std::uint32_t lo {0}, hi {free_bytes + probe_step};
+
+    __malloc_lock(_REENT);
+    while (hi - lo > probe_step)
+    {
+        std::uint32_t mid {lo + (hi - lo) / 2};
+        if (void *p {std::malloc(mid)})
+        {
+            std::free(p);
+            lo = mid;
+        }
+        else
+            hi = mid;
+    }
+    __malloc_unlock(_REENT);
+
+    return lo;
+}
+
+/// bytes sbrk hasn't handed out yet
+static std::uint32_t unclaimed(void)
+{
+    return static_cast<std::uint32_t>(_heap_end - static_cast<char *>(sbrk(0)));
+}
+
+static void sample(void)
+{
+    struct mallinfo info {mallinfo()};
+    std::uint32_t top {static_cast<std::uint32_t>(info.keepcost) + unclaimed()};
+
+    stats_lock.take(TIMEOUT_MAX);
+    bool was_low {stats.lowest_top_free != 0 && stats.lowest_top_free < low_free};
+    stats.live = info.uordblks;
+    stats.footprint = info.arena;
+    stats.top_free = top;
+    if (stats.live > stats.peak)
+        stats.peak = stats.live;
+    if (stats.lowest_top_free == 0 || top < stats.lowest_top_free)
+        stats.lowest_top_free = top;
+    heap_stats now {stats};
+    stats_lock.give();
+
+    if (!was_low && now.lowest_top_free < low_free)
+        BLOG(BLOG_WARN, BLOG_SYSTEM, "heap low: %u bytes free at the top, %u in use", now.top_free, now.live);
+
+    pros::lcd::print(7, "heap %u KB, peak %u KB, top free %u KB", now.live >> 10, now.peak >> 10, now.top_free >> 10);
+}
+
+static void monitor_loop(void)
+{
+    std::uint32_t now {pros::millis()};
+    while (true)
+    {
+        sample();
+        pros::Task::delay_until(&now, sample_ms);
+    }
+}
+
+void start_heap_monitor(void)
+{
+    static bool started {false};
+    if (started)
+        return;
+    started = true;
+
+    static pros::Task task {monitor_loop, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "heap"};
+}
+
+heap_stats heap_now(void)
+{
+    stats_lock.take(TIMEOUT_MAX);
+    heap_stats now {stats};
+    stats_lock.give();
+    return now;
+}
+
+void log_heap_high_water(const char *reason)
+{
+    // free inside the arena plus what sbrk has left is as big as any block can be
+    struct mallinfo info {mallinfo()};
+    std::uint32_t largest {probe_largest_free(static_cast<std::uint32_t>(info.fordblks) + unclaimed())};
+
+    stats_lock.take(TIMEOUT_MAX);
+    stats.largest_free = largest;
+    heap_stats now {stats};
+    stats.peak = stats.live;
+    stats.lowest_top_free = stats.top_free;
+    stats_lock.give();
+
+    BLOG(BLOG_INFO, BLOG_SYSTEM, "heap at %s: peak %u bytes, footprint %u, lowest top free %u, largest free block %u",
+         reason, now.peak, now.footprint, now.lowest_top_free, now.largest_free);
+
+#ifdef ALLOC_WATCH
+    // <=16, 32, 64, 128, 256, 512, 1024, bigger
+    BLOG(BLOG_INFO, BLOG_SYSTEM, "allocation sizes: %u %u %u %u %u %u %u %u",
+         alloc_sizes[0], alloc_sizes[1], alloc_sizes[2], alloc_sizes[3],
+         alloc_sizes[4], alloc_sizes[5], alloc_sizes[6], alloc_sizes[7]);
+#endif
+}
@@ -0,0 +1,141 @@
+//* hot path helpers
+
+//* headers and stuff
+#define ALLOC_WATCH_HOOKS   // operator new/delete live here when ALLOC_WATCH is on
+#include "globals.hpp"
+#include "blog.hpp"
+#include "hot_path.hpp"
+#include "main.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+//* global vars
+
+borrowed<chassis_model> drive_model;
+
+struct control_loop
+{
+    pros::task_t task;
+    const char *name;
+    std::array<const char *, 4> warned;     // warnings already printed for this loop
+    alloc_counts allocs;
+};
+
+static std::array<control_loop, 8> loops {};
+static std::atomic<std::size_t> loop_count {0};   // find_loop() reads it without the lock
+static pros::Mutex loops_lock;
+
+//* functions
+
+void register_control_loop(const char *name)
+{
+    pros::task_t self {pros::c::task_get_current()};
+
+    loops_lock.take(TIMEOUT_MAX);
+    std::size_t count {loop_count.load(std::memory_order_relaxed)};
+
+    // opcontrol starts driving()/controls() again after every disable, the new task
+    // takes over the old one's slot (and keeps its warnings and allocation counts)
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (std::strcmp(loops[i].name, name) == 0)
+        {
+            loops[i].task = self;
+            loops_lock.give();
+            return;
+        }
+    }
+
+    // fill the slot first, a reader that sees the new count sees a whole entry
+    if (count < loops.size())
+    {
+        loops[count] = {self, name, {}, {name, 0, 0, 0, {}, 0, false}};
+        loop_count.store(count + 1, std::memory_order_release);
+    }
+    else
+        BLOG(BLOG_WARN, BLOG_HOT_PATH, "no room to register %s", name);
+    loops_lock.give();
+}
+
+static control_loop *find_loop(void)
+{
+    // operator new lands here with ALLOC_WATCH, including during static init
+    std::size_t count {loop_count.load(std::memory_order_acquire)};
+    if (count == 0)
+        return nullptr;
+
+    pros::task_t self {pros::c::task_get_current()};
+
+    // no lock, register_control_loop() only publishes slots that are already filled in
+    for (std::size_t i = 0; i < count; ++i)
+        if (loops[i].task == self)
+            return &loops[i];
+    return nullptr;
+}
+
+const char *current_control_loop(void)
+{
+    control_loop *loop {find_loop()};
+    return loop ? loop->name : nullptr;
+}
+
+void hot_path_warning(const char *what)
+{
+    control_loop *loop {find_loop()};
+    const char *name {loop ? loop->name : pros::c::task_get_name(nullptr)};
+
+    if (loop)
+    {
+        for (const char *&seen : loop->warned)
+        {
+            if (seen != nullptr && std::strcmp(seen, what) == 0)
+                return;
+            if (seen == nullptr)
+            {
+                seen = what;
+                break;
+            }
+        }
+    }
+
+    BLOG(BLOG_WARN, BLOG_HOT_PATH, "%s: %s", name, what);
+}
+
+std::shared_ptr<okapi::ChassisModel> owned_drive_model(void)
+{
+#ifdef HOT_PATH_CHECKS
+    if (current_control_loop() != nullptr)
+        hot_path_warning("shared_ptr copy of the chassis model (refcount churn)");
+#endif
+    return chassis->getModel();
+}
+
+#ifdef ALLOC_WATCH
+
+alloc_counts *alloc_watch_counts(void)
+{
+    control_loop *loop {find_loop()};
+    return loop ? &loop->allocs : nullptr;
+}
+
+void alloc_watch_report(const alloc_counts &counts, void *site, std::size_t size)
+{
+    // addr2line -e bin/monolith.elf <site>
+    BLOG(BLOG_WARN, BLOG_HOT_PATH, "%s: %u byte allocation in a realtime region from 0x%08x",
+         counts.name, static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(site)));
+}
+
+#endif
+
+void log_loop_allocations(void)
+{
+#ifdef ALLOC_WATCH
+    std::size_t count {loop_count.load(std::memory_order_acquire)};
+    for (std::size_t i = 0; i < count; ++i)
+        BLOG(BLOG_INFO, BLOG_HOT_PATH, "%s: %u allocations, %u in realtime regions (%u from sites not reported)",
+             loops[i].name, loops[i].allocs.total, loops[i].allocs.realtime, loops[i].allocs.unreported);
+#endif
+}
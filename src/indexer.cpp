@@ -0,0 +1,94 @@
+//* conveyor indexing
+
+//* headers and stuff
+#include "globals.hpp"
+#include "ball_tracker.hpp"
+#include "indexer.hpp"
+#include "robot.hpp"
+#include "main.h"
+
+#include <cstdlib>
+#include <string>
+
+//* global vars
+
+static okapi::MotorGroup conveyors {
+    okapi::Motor{smart_port(mechanism_ports::convey_bot), is_reversed(mechanism_ports::convey_bot), mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts},
+    okapi::Motor{smart_port(mechanism_ports::convey_top), is_reversed(mechanism_ports::convey_top), mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts}
+};
+
+static standby<okapi::AsyncLinearMotionProfileController> index_controller;
+static volatile bool running {false};
+static volatile bool cancelled {false};     // index_cancel() from another task
+
+//* functions
+
+static std::string slot_id(int slots)
+{
+    return "index_" + std::to_string(slots);
+}
+
+void init_indexer(void)
+{
+    // mechanism_ports::rpm (600) on a 2 in roller is ~1.6 m/s
+    index_controller = standby<okapi::AsyncLinearMotionProfileController>{okapi::AsyncMotionProfileControllerBuilder()
+        .withLimits({1.4, 12.0, 60.0})
+        .withOutput(conveyors, conveyor_roller_diameter * okapi::inch, mechanism_gearset)
+        .buildLinearMotionProfileController()};
+
+    index_controller.get()->generatePath({0_in, ball_diameter * okapi::inch}, slot_id(1));
+    index_controller.get()->generatePath({0_in, 2 * ball_diameter * okapi::inch}, slot_id(2));
+}
+
+void index_step(int slots)
+{
+    if (!index_controller || slots == 0)
+        return;
+
+    index_stop();
+
+    // cached ones first, backwards is the same profile run in reverse
+    int size {std::abs(slots)};
+    if (size > 2)
+        index_controller.get()->generatePath({0_in, size * ball_diameter * okapi::inch}, slot_id(size));
+
+    index_controller->flipDisable(false);
+    index_controller->setTarget(slot_id(size), slots < 0);
+    running = true;
+}
+
+void index_stop(void)
+{
+    cancelled = false;
+    if (!running)
+        return;
+
+    running = false;
+    index_controller.get()->flipDisable(true);    // drops the current profile and stops the motors
+    index_controller.settle();
+
+    // the loop can get one more output in between flipDisable and the park, zero it again
+    conveyors.moveVoltage(0);
+}
+
+void index_cancel(void)
+{
+    cancelled = true;
+}
+
+bool indexing(void)
+{
+    if (cancelled)
+        index_stop();
+
+    // also parks the controller's thread once the profile's done
+    if (index_controller && index_controller.settle())
+        running = false;
+
+    return running;
+}
+
+std::uint32_t index_wakeups(void)
+{
+    return index_controller.wakeups();
+}
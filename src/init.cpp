@@ -2,6 +2,18 @@
 
 //* headers and stuff
 #include "globals.hpp"
+#include "blog.hpp"
+#include "heap_monitor.hpp"
+#include "hot_path.hpp"
+#include "indexer.hpp"
+#include "inputs.hpp"
+#include "localization.hpp"
+#include "motor_tuning.hpp"
+#include "odometry.hpp"
+#include "recorder.hpp"
+#include "relocalize.hpp"
+#include "routine.hpp"
+#include "sorter.hpp"
 #include "main.h"
 
 //* functions
@@ -11,15 +23,32 @@ void selection(void)
     int count {0};
     while (true)
     {
-        pros::lcd::print(0, "auto: %s", (count == 1) ? "skills" : "live  ");
+        pros::lcd::print(0, "auto: %s %s", (count == 1) ? "skills" : "live  ", (sel_alliance == alliance::RED) ? "red " : "blue");
 
         if (controller.getDigital(okapi::ControllerDigital::right) && count < 1)
             ++count;
         else if (controller.getDigital(okapi::ControllerDigital::left) && count > 0)
             --count;
+        else if (controller.getDigital(okapi::ControllerDigital::up))
+            sel_alliance = alliance::RED;
+        else if (controller.getDigital(okapi::ControllerDigital::down))
+            sel_alliance = alliance::BLUE;
+        else if (controller.getDigital(okapi::ControllerDigital::X))   // pits only, robot spins
+        {
+            result<okapi::QLength> offset {calibrate_middle_offset()};
+            if (offset)
+                pros::lcd::print(1, "middle offset: %.3f in", offset.value().convert(okapi::inch));
+            else
+                pros::lcd::print(1, "middle offset: %s", fault_name(offset.error()));
+        }
+        else if (controller.getDigital(okapi::ControllerDigital::Y))   // pits only, load balls first
+            tune_mechanisms();
+        else if (controller.getDigital(okapi::ControllerDigital::B))
+            pros::lcd::print(1, "flight recorder: %s", dump_recorder("manual") ? "saved" : "nothing new");
         else if (controller.getDigital(okapi::ControllerDigital::A))
         {
             sel_auto = (count == 1) ? auto_select::SKILLS : auto_select::LIVE;
+            our_color = (sel_alliance == alliance::RED) ? ball_color::RED : ball_color::BLUE;
             return;
         }
 
@@ -33,25 +62,36 @@ void selection(void)
 void initialize(void)
 {
     pros::lcd::initialize();
+    start_blog();
 
-    chassis = okapi::ChassisControllerBuilder()
-        .withMotors({19, 20}, {-9, -10})
-        .withDimensions(
-            okapi::AbstractMotor::gearset::green, 
-            {{4_in, 12_in}, okapi::imev5GreenTPR * (4.0/3.0)})
-        .withSensors(
-            okapi::ADIEncoder{'E', 'F', false},
-            okapi::ADIEncoder{'A', 'B', true}
-        )
-        .build();
+    load_middle_offset();
+    load_vel_gains();
+    chassis = build_chassis();
+    drive_model = borrowed<chassis_model>{std::static_pointer_cast<chassis_model>(chassis->getModel())};
+    start_inputs();
+    start_relocalize();
+    start_sorter();
+    init_indexer();
 
     selection();
+    build_routines();   // after selection, the alliance picks the routine
+
+    // the robot's on its tile by now, put odom and the filter there
+    pf_pose start {start_pose(sel_alliance)};
+    chassis->setState({start.x * okapi::inch, start.y * okapi::inch, start.theta * okapi::radian});
+    start_localize(start);
+
+    start_recorder();
+    start_heap_monitor();
 }
 
 /// disabled callback
 void disabled(void)
 {
-
+    dump_recorder("disabled");  // end of auto or the match
+    log_loop_allocations();
+    BLOG(BLOG_INFO, BLOG_SYSTEM, "controller wakeups: profile %u, index %u", profile_controller.wakeups(), index_wakeups());
+    log_heap_high_water("disabled");
 }
 
 /// comp init callback
@@ -0,0 +1,134 @@
+//* controller inputs
+
+//* headers and stuff
+#include "globals.hpp"
+#include "inputs.hpp"
+#include "main.h"
+
+#include <array>
+
+//* global vars
+
+input_split split {input_split::PARTNER_MECHANISMS};
+
+static constexpr int frame_ms {10};
+
+static input_frame latest {};
+static std::uint32_t sequence {0};      // frames published so far
+static std::array<pros::task_t, 4> waiters {};
+static pros::Mutex lock;
+
+//* functions
+
+/// fills in just the mechanism buttons, returns true if any are down
+static bool read_mechanisms(okapi::Controller &pad, input_frame &frame)
+{
+    frame.index = pad.getDigital(okapi::ControllerDigital::R1);
+    frame.cycle = pad.getDigital(okapi::ControllerDigital::R2);
+    frame.shoot = pad.getDigital(okapi::ControllerDigital::L1);
+    frame.intake = pad.getDigital(okapi::ControllerDigital::L2);
+    frame.eject = pad.getDigital(okapi::ControllerDigital::up);
+    frame.convey_down = pad.getDigital(okapi::ControllerDigital::down);
+    frame.itk_fast = pad.getDigital(okapi::ControllerDigital::left);
+    frame.itk_slow = pad.getDigital(okapi::ControllerDigital::right);
+
+    return frame.index || frame.cycle || frame.shoot || frame.intake
+        || frame.eject || frame.convey_down || frame.itk_fast || frame.itk_slow;
+}
+
+static input_frame sample(void)
+{
+    input_frame frame {};
+
+    frame.forward = controller.getAnalog(okapi::ControllerAnalog::rightY);
+    frame.yaw = controller.getAnalog(okapi::ControllerAnalog::rightX);
+    frame.align = controller.getDigital(okapi::ControllerDigital::A);
+    frame.hold_toggle = controller.getDigital(okapi::ControllerDigital::B);
+
+    input_split mode {split};
+    if (mode != input_split::MASTER_ONLY && !partner.isConnected())
+        mode = input_split::MASTER_ONLY;
+
+    switch (mode)
+    {
+        case input_split::MASTER_ONLY:
+            read_mechanisms(controller, frame);
+            break;
+        case input_split::PARTNER_MECHANISMS:
+            read_mechanisms(partner, frame);
+            break;
+        case input_split::SHARED:
+            if (!read_mechanisms(partner, frame))
+                read_mechanisms(controller, frame);
+            break;
+    }
+
+    return frame;
+}
+
+static void inputs_loop(void)
+{
+    std::uint32_t now {pros::millis()};
+    while (true)
+    {
+        input_frame frame {sample()};
+
+        lock.take(TIMEOUT_MAX);
+        latest = frame;
+        ++sequence;
+        for (pros::task_t task : waiters)
+            if (task != nullptr)
+                pros::c::task_notify(task);
+        lock.give();
+
+        pros::Task::delay_until(&now, frame_ms);
+    }
+}
+
+void start_inputs(void)
+{
+    static bool started {false};
+    if (started)
+        return;
+    started = true;
+
+    static pros::Task task {inputs_loop, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "inputs"};
+}
+
+input_frame read_inputs(void)
+{
+    lock.take(TIMEOUT_MAX);
+    input_frame out {latest};
+    lock.give();
+    return out;
+}
+
+input_frame next_inputs(std::uint32_t &seen)
+{
+    pros::task_t self {pros::c::task_get_current()};
+
+    // only tasks that are waiting right now get notified, so a finished loop never does
+    lock.take(TIMEOUT_MAX);
+    pros::task_t *slot {nullptr};
+    while (sequence == seen)
+    {
+        if (slot == nullptr)
+            for (pros::task_t &task : waiters)
+                if (task == nullptr)
+                {
+                    task = self;
+                    slot = &task;
+                    break;
+                }
+        lock.give();
+        pros::c::task_notify_take(true, slot ? 2 * frame_ms : 1);  // no free slot, poll
+        lock.take(TIMEOUT_MAX);
+    }
+    if (slot)
+        *slot = nullptr;
+    seen = sequence;
+    input_frame out {latest};
+    lock.give();
+
+    return out;
+}
@@ -0,0 +1,107 @@
+//* particle filter localization
+
+//* headers and stuff
+#include "globals.hpp"
+#include "devices.hpp"
+#include "hot_path.hpp"
+#include "localization.hpp"
+#include "relocalize.hpp"
+#include "main.h"
+
+#include <cmath>
+
+//* global vars
+
+static constexpr int update_ms {20};
+static constexpr double vision_fov {61.0 * M_PI / 180.0};
+static constexpr pf_mount camera {0.0, 6.0, 0.0};
+
+static particle_filter filter;
+static pros::Mutex pose_lock;
+static pf_pose pose {0.0, 0.0, 0.0};
+static double imu_offset {0.0};
+
+//* functions
+
+static pf_pose odom_pose(void)
+{
+    auto state {chassis->getState()};   // CARTESIAN, set in build_chassis()
+    return {state.x.convert(okapi::inch), state.y.convert(okapi::inch), state.theta.convert(okapi::radian)};
+}
+
+static void localize_loop(void)
+{
+    register_control_loop("localization");
+
+    std::array<pros::Distance, distance_count> sensors {{
+        pros::Distance{distance_mounts[0].port},
+        pros::Distance{distance_mounts[1].port}
+    }};
+
+    pf_pose last {odom_pose()};
+    std::uint32_t now {pros::millis()};
+    while (true)
+    {
+        pros::Task::delay_until(&now, update_ms);
+        realtime_region frame;
+
+        // odom delta, rotated into the robot frame at the last heading
+        pf_pose odom {odom_pose()};
+        double dx {odom.x - last.x}, dy {odom.y - last.y};
+        double forward {dx * std::sin(last.theta) + dy * std::cos(last.theta)};
+        double strafe {dx * std::cos(last.theta) - dy * std::sin(last.theta)};
+        double travel {std::abs(forward) + std::abs(strafe)};
+        filter.predict(forward, strafe, odom.theta - last.theta, 0.05 + 0.1 * travel, 0.002 + 0.05 * std::abs(odom.theta - last.theta));
+        last = odom;
+
+        if (result<double> rotation {imu_rotation(imu)})
+            filter.observe_heading(rotation.value() * M_PI / 180.0 + imu_offset, 0.03);
+
+        for (std::size_t s = 0; s < distance_count; ++s)
+        {
+            result<double> measured {distance_inches(sensors[s], 45)};
+            if (!measured)
+                continue;
+
+            const distance_mount &m {distance_mounts[s]};
+            filter.observe_distance({m.x, m.y, m.angle * M_PI / 180.0}, measured.value(), 1.0);
+        }
+
+        pros::vision_object_s_t goal {vision.get_by_sig(0, goal_sig)};
+        if (goal.signature != VISION_OBJECT_ERR_SIG && goal.width > 10)
+        {
+            double bearing {(goal.x_middle_coord - VISION_FOV_WIDTH / 2.0) / VISION_FOV_WIDTH * vision_fov};
+            filter.observe_goal(camera, bearing, 0.05);
+        }
+
+        if (filter.effective_size() < particle_filter::capacity / 2)
+            filter.resample();
+
+        pf_pose estimate {filter.estimate()};
+        pose_lock.take(TIMEOUT_MAX);
+        pose = estimate;
+        pose_lock.give();
+    }
+}
+
+void start_localize(const pf_pose &start)
+{
+    static bool started {false};
+    if (started)
+        return;
+    started = true;
+
+    filter.init(start, 1.0, 0.02);
+    imu_offset = start.theta - imu_rotation(imu).value_or(0.0) * M_PI / 180.0;
+    pose = start;
+
+    static pros::Task task {localize_loop, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "localize"};
+}
+
+pf_pose localize_pose(void)
+{
+    pose_lock.take(TIMEOUT_MAX);
+    pf_pose out {pose};
+    pose_lock.give();
+    return out;
+}
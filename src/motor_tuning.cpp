@@ -0,0 +1,207 @@
+//* mechanism motor velocity pid tuning
+
+//* headers and stuff
+#include "globals.hpp"
+#include "motor_tuning.hpp"
+#include "robot.hpp"
+#include "main.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+
+//* global vars
+
+struct mechanism
+{
+    std::uint8_t port;
+    bool reversed;
+    vel_gains gains;
+    bool tuned;
+};
+
+// intakes, convey_top, convey_bot. seed gains are just a starting point for the search.
+static std::array<mechanism, 4> mechanisms {{
+    {smart_port(mechanism_ports::intakes[0]), is_reversed(mechanism_ports::intakes[0]), {1.0, 1.0, 0.1, 0.0, 0.0, 0.0, 10.0}, false},
+    {smart_port(mechanism_ports::intakes[1]), is_reversed(mechanism_ports::intakes[1]), {1.0, 1.0, 0.1, 0.0, 0.0, 0.0, 10.0}, false},
+    {smart_port(mechanism_ports::convey_top), is_reversed(mechanism_ports::convey_top), {1.0, 1.0, 0.1, 0.0, 0.0, 0.0, 10.0}, false},
+    {smart_port(mechanism_ports::convey_bot), is_reversed(mechanism_ports::convey_bot), {1.0, 1.0, 0.1, 0.0, 0.0, 0.0, 10.0}, false}
+}};
+
+static const char *gains_file {"/usd/vel_pid.txt"};
+static constexpr int step_rpm {500};
+static constexpr int step_mv {6000};        // open loop step, half voltage so it stays off the limit
+static constexpr int step_ms {600};
+static constexpr int sample_ms {10};
+static constexpr int samples {step_ms / sample_ms};
+
+//* functions
+
+static void apply(okapi::Motor &motor, const vel_gains &g)
+{
+    motor.setVelPIDFull(g.kf, g.kp, g.ki, g.kd, g.filter, g.limit, 0.0, g.loopspeed);
+}
+
+/// runs 0 -> step_rpm and scores it, lower is better. time weighted error punishes a slow
+/// recovery, overshoot gets an extra penalty since it double feeds balls.
+/// `g` nullptr runs whatever gains the motor already has.
+static double step_cost(okapi::Motor &motor, const vel_gains *g, std::array<double, samples> *log)
+{
+    if (g)
+        apply(motor, *g);
+    motor.moveVelocity(0);
+    pros::delay(400);
+
+    double cost {0.0}, peak {0.0};
+    std::uint32_t now {pros::millis()};
+    motor.moveVelocity(step_rpm);
+    for (int i = 0; i < samples; ++i)
+    {
+        pros::Task::delay_until(&now, sample_ms);
+        double rpm {std::abs(motor.getActualVelocity())};
+        if (log)
+            (*log)[i] = rpm;
+
+        cost += (i + 1) * sample_ms * std::abs(step_rpm - rpm) * 1e-3;
+        peak = std::max(peak, rpm);
+    }
+    motor.moveVelocity(0);
+
+    double overshoot {std::max(0.0, peak - step_rpm)};
+    return cost + 20.0 * overshoot;
+}
+
+/// coordinate descent on kp, ki, kd in 4.4 fixed point steps (1/16), halving the step
+/// whenever nothing improves
+static vel_gains tune(okapi::Motor &motor, vel_gains best)
+{
+    double best_cost {step_cost(motor, &best, nullptr)};
+    double step {1.0};
+
+    while (step >= 0.125)
+    {
+        bool improved {false};
+        for (double vel_gains::*gain : {&vel_gains::kp, &vel_gains::ki, &vel_gains::kd})
+        {
+            for (double dir : {1.0, -1.0})
+            {
+                vel_gains trial {best};
+                trial.*gain = std::min(15.9375, std::max(0.0, trial.*gain + dir * step));
+                if (trial.*gain == best.*gain)
+                    continue;
+
+                double cost {step_cost(motor, &trial, nullptr)};
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best = trial;
+                    improved = true;
+                }
+            }
+        }
+
+        if (!improved)
+            step /= 2.0;
+    }
+
+    return best;
+}
+
+/// 0 -> step_mv with the velocity loop out of the way, for tools/vel_pid_fit.cpp
+static void open_step(okapi::Motor &motor, std::array<double, samples> &log)
+{
+    motor.moveVoltage(0);
+    pros::delay(400);
+
+    std::uint32_t now {pros::millis()};
+    motor.moveVoltage(step_mv);
+    for (int i = 0; i < samples; ++i)
+    {
+        pros::Task::delay_until(&now, sample_ms);
+        log[i] = std::abs(motor.getActualVelocity());
+    }
+    motor.moveVoltage(0);
+}
+
+static void save(void)
+{
+    FILE *file {std::fopen(gains_file, "w")};
+    if (file == nullptr)
+        return;
+
+    for (const mechanism &m : mechanisms)
+        if (m.tuned)
+            std::fprintf(file, "%d %f %f %f %f %f %f %f\n", m.port, m.gains.kf, m.gains.kp,
+                m.gains.ki, m.gains.kd, m.gains.filter, m.gains.limit, m.gains.loopspeed);
+
+    std::fclose(file);
+}
+
+/// closed loop logs are t_ms,target_rpm,rpm, the open loop one t_ms,mv,rpm
+static void save_log(int port, const char *label, bool open, const std::array<double, samples> &log)
+{
+    char name[48];
+    std::snprintf(name, sizeof(name), "/usd/step_%d_%s.csv", port, label);
+    FILE *file {std::fopen(name, "w")};
+    if (file == nullptr)
+        return;
+
+    std::fprintf(file, open ? "t_ms,mv,rpm\n" : "t_ms,target_rpm,rpm\n");
+    for (int i = 0; i < samples; ++i)
+        std::fprintf(file, "%d,%d,%f\n", (i + 1) * sample_ms, open ? step_mv : step_rpm, log[i]);
+
+    std::fclose(file);
+}
+
+void load_vel_gains(void)
+{
+    FILE *file {std::fopen(gains_file, "r")};
+    if (file == nullptr)
+        return;
+
+    int port {0};
+    vel_gains g {};
+    while (std::fscanf(file, "%d %lf %lf %lf %lf %lf %lf %lf", &port, &g.kf, &g.kp, &g.ki,
+        &g.kd, &g.filter, &g.limit, &g.loopspeed) == 8)
+    {
+        for (mechanism &m : mechanisms)
+        {
+            if (m.port != port)
+                continue;
+
+            okapi::Motor motor {m.port, m.reversed, mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts};
+            apply(motor, g);
+            m.gains = g;
+            m.tuned = true;
+        }
+    }
+
+    std::fclose(file);
+}
+
+void tune_mechanisms(void)
+{
+    std::array<double, samples> log;
+
+    for (mechanism &m : mechanisms)
+    {
+        okapi::Motor motor {m.port, m.reversed, mechanism_gearset, okapi::AbstractMotor::encoderUnits::counts};
+        pros::lcd::print(2, "tuning port %d", m.port);
+
+        open_step(motor, log);
+        save_log(m.port, "open", true, log);
+
+        // whatever the motor runs now: the firmware's gains, unless load_vel_gains() found some
+        step_cost(motor, nullptr, &log);
+        save_log(m.port, "before", false, log);
+
+        m.gains = tune(motor, m.gains);
+        m.tuned = true;
+
+        step_cost(motor, &m.gains, &log);
+        save_log(m.port, "after", false, log);
+    }
+
+    save();
+    pros::lcd::print(2, "tuning done");
+}
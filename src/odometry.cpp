@@ -0,0 +1,142 @@
+//* odometry stuff
+
+//* headers and stuff
+#include "globals.hpp"
+#include "hot_path.hpp"
+#include "odometry.hpp"
+#include "tracking.hpp"
+#include "main.h"
+
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+//* global vars
+
+okapi::QLength middle_offset {tracking_layout::middle_offset * okapi::inch};
+
+static const char *middle_offset_file {"/usd/middle_offset.txt"};
+static constexpr std::uint32_t turn_timeout_ms {6000};     // a 0.25 speed turn takes ~3 s
+
+//* functions
+
+static pros::ADIEncoder encoder(const adi_encoder_ports &ports)
+{
+    return {ports.top, ports.bottom, ports.reversed};
+}
+
+/// MotorGroup only takes an initializer_list, so the ports get unpacked
+template <std::size_t... I>
+static std::shared_ptr<okapi::MotorGroup> motor_group(const std::array<std::int8_t, sizeof...(I)> &ports, std::index_sequence<I...>)
+{
+    return std::make_shared<okapi::MotorGroup>(std::initializer_list<okapi::Motor>{okapi::Motor{ports[I]}...});
+}
+
+okapi::ChassisScales odom_scales(void)
+{
+    return {{tracking_layout::diameter * okapi::inch, tracking_layout::track * okapi::inch, middle_offset,
+             tracking_layout::middle_diameter * okapi::inch}, tracking_layout::tpr};
+}
+
+std::shared_ptr<okapi::OdomChassisController> build_chassis(void)
+{
+    // the odom thread in okapi steps every 10 ms, same as the adi update rate,
+    // so every step sees fresh encoder counts. integration is arc based
+    // (tracking_odometry), so the middle wheel picks up scrub and pushing.
+    auto wheels {std::make_shared<tracking_wheels>(
+        encoder(tracking_layout::left),
+        encoder(tracking_layout::right),
+        encoder(tracking_layout::middle)
+    )};
+
+    // put together by hand, the builder only makes okapi's own models. the motor groups
+    // are for the integrated moveDistance/turnAngle, everything open loop (teleop, motion
+    // profiles) goes through chassis_model.
+    const okapi::AbstractMotor::GearsetRatioPair gearset {static_cast<okapi::AbstractMotor::gearset>(drivetrain::rpm)};
+    const okapi::ChassisScales scales {{drivetrain::wheel_diameter * okapi::inch, drivetrain::track * okapi::inch}, drivetrain::tpr};
+    constexpr std::int32_t max_velocity {drivetrain::rpm};
+
+    auto left {motor_group(drivetrain::left, std::make_index_sequence<drivetrain::count>{})};
+    auto right {motor_group(drivetrain::right, std::make_index_sequence<drivetrain::count>{})};
+
+    auto controller {std::make_shared<okapi::ChassisControllerIntegrated>(
+        okapi::TimeUtilFactory::createDefault(),
+        std::make_shared<chassis_model>(wheels),
+        std::make_unique<okapi::AsyncPosIntegratedController>(left, gearset, max_velocity, okapi::TimeUtilFactory::createDefault()),
+        std::make_unique<okapi::AsyncPosIntegratedController>(right, gearset, max_velocity, okapi::TimeUtilFactory::createDefault()),
+        gearset,
+        scales
+    )};
+
+    auto out {std::make_shared<okapi::DefaultOdomChassisController>(
+        okapi::TimeUtilFactory::createDefault(),
+        std::make_shared<tracking_odometry>(wheels, odom_scales()),
+        controller,
+        okapi::StateMode::CARTESIAN
+    )};
+    out->startOdomThread();
+    return out;
+}
+
+void load_middle_offset(void)
+{
+    FILE *file {std::fopen(middle_offset_file, "r")};
+    if (file == nullptr)
+        return;
+
+    double inches {0.0};
+    if (std::fscanf(file, "%lf", &inches) == 1 && std::isfinite(inches))   // negative is behind center
+        middle_offset = inches * okapi::inch;
+
+    std::fclose(file);
+}
+
+result<okapi::QLength> calibrate_middle_offset(int turns)
+{
+    auto model {owned_drive_model()};
+    model->resetSensors();
+
+    constexpr double rad_per_tick {tracking_layout::scales.per_tick * tracking_layout::scales.inv_track};
+    constexpr double middle {tracking_layout::scales.middle_per_tick};
+    const double target {turns * 2.0 * M_PI};
+    const std::uint32_t deadline {pros::millis() + turns * turn_timeout_ms};
+
+    // spin slowly so the wheels don't slip, heading comes from the parallel wheels
+    double theta {0.0};
+    double middle_dist {0.0};
+    while (std::abs(theta) < target)
+    {
+        if (pros::millis() > deadline)
+        {
+            model->stop();
+            return fault::TIMED_OUT;
+        }
+
+        model->rotate(0.25);
+        pros::delay(10);
+
+        auto ticks {model->getSensorVals()};
+        theta = (ticks[0] - ticks[1]) * rad_per_tick;
+        middle_dist = ticks[2] * middle;
+    }
+    model->stop();
+    pros::delay(250);   // let it settle, then take the final reading
+
+    auto ticks {model->getSensorVals()};
+    theta = (ticks[0] - ticks[1]) * rad_per_tick;
+    middle_dist = ticks[2] * middle;
+
+    // a pure rotation moves the middle wheel by offset * theta
+    middle_offset = (middle_dist / theta) * okapi::inch;
+
+    FILE *file {std::fopen(middle_offset_file, "w")};
+    if (file != nullptr)
+    {
+        std::fprintf(file, "%f\n", middle_offset.convert(okapi::inch));
+        std::fclose(file);
+    }
+
+    // swap the scales in place, the chassis and drive model stay put for the tasks already using them
+    chassis->getOdometry()->setScales(odom_scales());
+    return middle_offset;
+}
@@ -0,0 +1,312 @@
+//* monte carlo localization
+
+//* headers and stuff
+#include "particle_filter.hpp"
+#include "field.hpp"
+
+#include <cmath>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+//* helpers
+
+#if defined(__ARM_NEON)
+/// 1 / d, estimate plus two newton steps
+static inline float32x4_t recip(float32x4_t d)
+{
+    float32x4_t r {vrecpeq_f32(d)};
+    r = vmulq_f32(vrecpsq_f32(d, r), r);
+    return vmulq_f32(vrecpsq_f32(d, r), r);
+}
+
+/// 1 / sqrt(n), estimate plus two newton steps
+static inline float32x4_t rsqrt(float32x4_t n)
+{
+    float32x4_t r {vrsqrteq_f32(n)};
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(n, r), r));
+    return vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(n, r), r));
+}
+
+/// keeps the sign but pushes |d| to at least eps so the divide stays finite
+static inline float32x4_t away_from_zero(float32x4_t d, float eps)
+{
+    uint32x4_t pos {vcgeq_f32(d, vdupq_n_f32(0.0f))};
+    return vbslq_f32(pos, vmaxq_f32(d, vdupq_n_f32(eps)), vminq_f32(d, vdupq_n_f32(-eps)));
+}
+#endif
+
+static inline float away_from_zero(float d, float eps)
+{
+    return (d >= 0.0f) ? ((d > eps) ? d : eps) : ((d < -eps) ? d : -eps);
+}
+
+//* functions
+
+particle_filter::particle_filter(std::uint32_t seed)
+    : m_rng{seed ? seed : 1}
+{
+    init({field_size / 2, field_size / 2, 0.0}, field_size / 2, M_PI);
+}
+
+float particle_filter::uniform(void)
+{
+    // xorshift32, top 24 bits -> [0, 1)
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 17;
+    m_rng ^= m_rng << 5;
+    return (m_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+float particle_filter::gaussian(void)
+{
+    // sum of four uniforms, close enough to normal and much cheaper than box-muller
+    return (uniform() + uniform() + uniform() + uniform() - 2.0f) * 1.7320508f;
+}
+
+void particle_filter::init(const pf_pose &pose, double spread_xy, double spread_theta)
+{
+    for (int i = 0; i < capacity; ++i)
+    {
+        m_x[i] = pose.x + spread_xy * gaussian();
+        m_y[i] = pose.y + spread_xy * gaussian();
+        m_theta[i] = pose.theta + spread_theta * gaussian();
+        m_cos[i] = std::cos(m_theta[i]);
+        m_sin[i] = std::sin(m_theta[i]);
+        m_lw[i] = 0.0f;
+    }
+}
+
+void particle_filter::predict(double forward, double strafe, double dtheta, double noise_xy, double noise_theta)
+{
+    for (int i = 0; i < capacity; ++i)
+    {
+        float f {static_cast<float>(forward + noise_xy * gaussian())};
+        float s {static_cast<float>(strafe + noise_xy * gaussian())};
+
+        // move along the heading at the start of the step
+        m_x[i] += f * m_sin[i] + s * m_cos[i];
+        m_y[i] += f * m_cos[i] - s * m_sin[i];
+
+        m_theta[i] += dtheta + noise_theta * gaussian();
+        m_cos[i] = std::cos(m_theta[i]);
+        m_sin[i] = std::sin(m_theta[i]);
+    }
+}
+
+void particle_filter::observe_heading(double theta, double sigma)
+{
+    // von mises instead of a wrapped gaussian, so it's just a dot product with the cached cos/sin
+    const float kappa {static_cast<float>(1.0 / (sigma * sigma))};
+    const float ch {static_cast<float>(std::cos(theta))};
+    const float sh {static_cast<float>(std::sin(theta))};
+
+#if defined(__ARM_NEON)
+    const float32x4_t vk {vdupq_n_f32(kappa)};
+    const float32x4_t one {vdupq_n_f32(1.0f)};
+    for (int i = 0; i < capacity; i += 4)
+    {
+        float32x4_t dot {vmulq_n_f32(vld1q_f32(m_cos + i), ch)};
+        dot = vmlaq_n_f32(dot, vld1q_f32(m_sin + i), sh);
+        vst1q_f32(m_lw + i, vmlaq_f32(vld1q_f32(m_lw + i), vk, vsubq_f32(dot, one)));
+    }
+#else
+    for (int i = 0; i < capacity; ++i)
+        m_lw[i] += kappa * (m_cos[i] * ch + m_sin[i] * sh - 1.0f);
+#endif
+}
+
+void particle_filter::observe_distance(const pf_mount &mount, double measured, double sigma)
+{
+    const float k {static_cast<float>(0.5 / (sigma * sigma))};
+    const float floor {static_cast<float>(-3.0 * sigma)};
+    const float m {static_cast<float>(measured)};
+    const float mx {static_cast<float>(mount.x)}, my {static_cast<float>(mount.y)};
+    const float ca {static_cast<float>(std::cos(mount.angle))};
+    const float sa {static_cast<float>(std::sin(mount.angle))};
+    const float w {static_cast<float>(field_size)};
+    const float eps {1e-4f};
+
+#if defined(__ARM_NEON)
+    const float32x4_t zero {vdupq_n_f32(0.0f)};
+    const float32x4_t vw {vdupq_n_f32(w)};
+    for (int i = 0; i < capacity; i += 4)
+    {
+        float32x4_t c {vld1q_f32(m_cos + i)}, s {vld1q_f32(m_sin + i)};
+
+        // sensor position and beam direction in field axes
+        float32x4_t sx {vmlaq_n_f32(vmlaq_n_f32(vld1q_f32(m_x + i), c, mx), s, my)};
+        float32x4_t sy {vmlaq_n_f32(vmlsq_n_f32(vld1q_f32(m_y + i), s, mx), c, my)};
+        float32x4_t dx {vmlaq_n_f32(vmulq_n_f32(s, ca), c, sa)};
+        float32x4_t dy {vmlsq_n_f32(vmulq_n_f32(c, ca), s, sa)};
+
+        // distance to whichever of the two walls the beam is heading towards
+        float32x4_t wx {vbslq_f32(vcgeq_f32(dx, zero), vw, zero)};
+        float32x4_t wy {vbslq_f32(vcgeq_f32(dy, zero), vw, zero)};
+        float32x4_t tx {vmulq_f32(vsubq_f32(wx, sx), recip(away_from_zero(dx, eps)))};
+        float32x4_t ty {vmulq_f32(vsubq_f32(wy, sy), recip(away_from_zero(dy, eps)))};
+        float32x4_t t {vmaxq_f32(vminq_f32(tx, ty), zero)};
+
+        float32x4_t err {vmaxq_f32(vsubq_f32(vdupq_n_f32(m), t), vdupq_n_f32(floor))};
+        vst1q_f32(m_lw + i, vmlsq_n_f32(vld1q_f32(m_lw + i), vmulq_f32(err, err), k));
+    }
+#else
+    for (int i = 0; i < capacity; ++i)
+    {
+        float c {m_cos[i]}, s {m_sin[i]};
+
+        float sx {m_x[i] + mx * c + my * s};
+        float sy {m_y[i] - mx * s + my * c};
+        float dx {s * ca + c * sa};
+        float dy {c * ca - s * sa};
+
+        float tx {((dx >= 0.0f ? w : 0.0f) - sx) / away_from_zero(dx, eps)};
+        float ty {((dy >= 0.0f ? w : 0.0f) - sy) / away_from_zero(dy, eps)};
+        float t {tx < ty ? tx : ty};
+        if (t < 0.0f)
+            t = 0.0f;
+
+        float err {m - t};
+        if (err < floor)
+            err = floor;
+        m_lw[i] -= k * err * err;
+    }
+#endif
+}
+
+void particle_filter::observe_goal(const pf_mount &camera, double bearing, double sigma)
+{
+    // compare the seen direction with the direction to each goal, take the best match
+    const float kappa {static_cast<float>(1.0 / (sigma * sigma))};
+    const float mx {static_cast<float>(camera.x)}, my {static_cast<float>(camera.y)};
+    const float cb {static_cast<float>(std::cos(camera.angle + bearing))};
+    const float sb {static_cast<float>(std::sin(camera.angle + bearing))};
+
+#if defined(__ARM_NEON)
+    const float32x4_t tiny {vdupq_n_f32(1e-6f)};
+    for (int i = 0; i < capacity; i += 4)
+    {
+        float32x4_t c {vld1q_f32(m_cos + i)}, s {vld1q_f32(m_sin + i)};
+        float32x4_t cx {vmlaq_n_f32(vmlaq_n_f32(vld1q_f32(m_x + i), c, mx), s, my)};
+        float32x4_t cy {vmlaq_n_f32(vmlsq_n_f32(vld1q_f32(m_y + i), s, mx), c, my)};
+        float32x4_t vx {vmlaq_n_f32(vmulq_n_f32(s, cb), c, sb)};
+        float32x4_t vy {vmlsq_n_f32(vmulq_n_f32(c, cb), s, sb)};
+
+        float32x4_t best {vdupq_n_f32(-1.0f)};
+        for (int g = 0; g < goal_count; ++g)
+        {
+            float32x4_t ux {vsubq_f32(vdupq_n_f32(goals[g].x), cx)};
+            float32x4_t uy {vsubq_f32(vdupq_n_f32(goals[g].y), cy)};
+            float32x4_t len {vmlaq_f32(vmlaq_f32(tiny, ux, ux), uy, uy)};
+            float32x4_t dot {vmulq_f32(vmlaq_f32(vmulq_f32(ux, vx), uy, vy), rsqrt(len))};
+            best = vmaxq_f32(best, dot);
+        }
+
+        vst1q_f32(m_lw + i, vmlaq_n_f32(vld1q_f32(m_lw + i), vsubq_f32(best, vdupq_n_f32(1.0f)), kappa));
+    }
+#else
+    for (int i = 0; i < capacity; ++i)
+    {
+        float c {m_cos[i]}, s {m_sin[i]};
+        float cx {m_x[i] + mx * c + my * s};
+        float cy {m_y[i] - mx * s + my * c};
+        float vx {s * cb + c * sb};
+        float vy {c * cb - s * sb};
+
+        float best {-1.0f};
+        for (int g = 0; g < goal_count; ++g)
+        {
+            float ux {static_cast<float>(goals[g].x) - cx};
+            float uy {static_cast<float>(goals[g].y) - cy};
+            float dot {(ux * vx + uy * vy) / std::sqrt(ux * ux + uy * uy + 1e-6f)};
+            if (dot > best)
+                best = dot;
+        }
+
+        m_lw[i] += kappa * (best - 1.0f);
+    }
+#endif
+}
+
+void particle_filter::normalize(float *weights) const
+{
+    float top {m_lw[0]};
+    for (int i = 1; i < capacity; ++i)
+        if (m_lw[i] > top)
+            top = m_lw[i];
+
+    float sum {0.0f};
+    for (int i = 0; i < capacity; ++i)
+    {
+        weights[i] = std::exp(m_lw[i] - top);
+        sum += weights[i];
+    }
+
+    for (int i = 0; i < capacity; ++i)
+        weights[i] /= sum;
+}
+
+double particle_filter::effective_size(void) const
+{
+    float weights[capacity];
+    normalize(weights);
+
+    double sum_sq {0.0};
+    for (int i = 0; i < capacity; ++i)
+        sum_sq += weights[i] * weights[i];
+
+    return 1.0 / sum_sq;
+}
+
+void particle_filter::resample(void)
+{
+    float weights[capacity];
+    normalize(weights);
+
+    float x[capacity], y[capacity], theta[capacity], c[capacity], s[capacity];
+
+    // one random offset, then evenly spaced picks along the cumulative weights
+    const float step {1.0f / capacity};
+    float u {uniform() * step};
+    float cumulative {weights[0]};
+    int j {0};
+    for (int i = 0; i < capacity; ++i, u += step)
+    {
+        while (u > cumulative && j < capacity - 1)
+            cumulative += weights[++j];
+
+        x[i] = m_x[j];
+        y[i] = m_y[j];
+        theta[i] = m_theta[j];
+        c[i] = m_cos[j];
+        s[i] = m_sin[j];
+    }
+
+    for (int i = 0; i < capacity; ++i)
+    {
+        m_x[i] = x[i];
+        m_y[i] = y[i];
+        m_theta[i] = theta[i];
+        m_cos[i] = c[i];
+        m_sin[i] = s[i];
+        m_lw[i] = 0.0f;
+    }
+}
+
+pf_pose particle_filter::estimate(void) const
+{
+    float weights[capacity];
+    normalize(weights);
+
+    double x {0.0}, y {0.0}, c {0.0}, s {0.0};
+    for (int i = 0; i < capacity; ++i)
+    {
+        x += weights[i] * m_x[i];
+        y += weights[i] * m_y[i];
+        c += weights[i] * m_cos[i];
+        s += weights[i] * m_sin[i];
+    }
+
+    return {x, y, std::atan2(s, c)};
+}
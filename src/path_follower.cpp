@@ -0,0 +1,103 @@
+//* path follower stuff
+
+//* headers and stuff
+#include "path_follower.hpp"
+
+#include <cmath>
+
+//* functions
+
+path_follower::path_follower(const Segment *segments, std::size_t length, std::size_t window, std::size_t backtrack)
+    : m_segments{segments}, m_length{length}, m_window{window > 0 ? window : 1}, m_backtrack{backtrack}
+{
+    // arc length table, built once so lookahead is just a walk along it
+    m_arc.resize(m_length);
+    double sum {0.0};
+    for (std::size_t i = 0; i < m_length; ++i)
+    {
+        if (i > 0)
+            sum += std::hypot(m_segments[i].x - m_segments[i - 1].x, m_segments[i].y - m_segments[i - 1].y);
+        m_arc[i] = sum;
+    }
+}
+
+double path_follower::dist_sq(std::size_t index, double x, double y) const
+{
+    double dx {m_segments[index].x - x};
+    double dy {m_segments[index].y - y};
+    return dx * dx + dy * dy;
+}
+
+std::size_t path_follower::closest(double x, double y)
+{
+    if (m_length == 0)
+        return 0;
+
+    std::size_t begin {m_cursor > m_backtrack ? m_cursor - m_backtrack : 0};
+    std::size_t end {m_cursor + m_window < m_length ? m_cursor + m_window : m_length - 1};
+
+    std::size_t best {begin};
+    double best_dist {dist_sq(begin, x, y)};
+    for (std::size_t i = begin + 1; i <= end; ++i)
+    {
+        double d {dist_sq(i, x, y)};
+        if (d < best_dist)
+        {
+            best_dist = d;
+            best = i;
+        }
+    }
+
+    // best sat on the edge of the window, so keep walking while it gets closer.
+    // the cursor only goes forward, so this is amortized over the whole path.
+    while (best == end && end + 1 < m_length)
+    {
+        double d {dist_sq(end + 1, x, y)};
+        if (d >= best_dist)
+            break;
+        best_dist = d;
+        best = ++end;
+    }
+
+    // small backtracks are reported but don't drag the cursor back
+    m_nearest = best;
+    if (best > m_cursor)
+        m_cursor = best;
+
+    return best;
+}
+
+Coord path_follower::lookahead(double distance)
+{
+    if (m_length == 0)
+        return Coord{0.0, 0.0};
+
+    double target {m_arc[m_nearest] + distance};
+
+    if (m_ahead < m_nearest)
+        m_ahead = m_nearest;
+    while (m_ahead + 1 < m_length && m_arc[m_ahead] < target)
+        ++m_ahead;
+    while (m_ahead > m_nearest && m_arc[m_ahead - 1] >= target)    // lookahead got shorter
+        --m_ahead;
+
+    const Segment &b {m_segments[m_ahead]};
+    if (m_ahead == 0 || m_arc[m_ahead] <= target)
+        return Coord{b.x, b.y};
+
+    // interpolate between the two segments straddling the target distance
+    const Segment &a {m_segments[m_ahead - 1]};
+    double span {m_arc[m_ahead] - m_arc[m_ahead - 1]};
+    double t {span > 0.0 ? (target - m_arc[m_ahead - 1]) / span : 1.0};
+    if (t < 0.0)
+        t = 0.0;
+
+    return Coord{a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t};
+}
+
+void path_follower::reset(void)
+{
+    m_cursor = 0;
+    m_nearest = 0;
+    m_ahead = 0;
+}
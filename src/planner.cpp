@@ -0,0 +1,169 @@
+//* field path planner
+
+//* headers and stuff
+#include "planner.hpp"
+
+#include <cmath>
+
+//* helpers
+
+static double dist(const plan_point &a, const plan_point &b)
+{
+    return std::hypot(b.x - a.x, b.y - a.y);
+}
+
+/// distance from c to the segment ab
+static double segment_dist(const plan_point &a, const plan_point &b, const plan_point &c)
+{
+    double dx {b.x - a.x}, dy {b.y - a.y};
+    double len_sq {dx * dx + dy * dy};
+    double t {len_sq > 0.0 ? ((c.x - a.x) * dx + (c.y - a.y) * dy) / len_sq : 0.0};
+    t = (t < 0.0) ? 0.0 : (t > 1.0) ? 1.0 : t;
+    return std::hypot(a.x + t * dx - c.x, a.y + t * dy - c.y);
+}
+
+//* functions
+
+field_planner::field_planner(double robot_width, double robot_length, double margin)
+    : m_robot_radius{std::hypot(robot_width, robot_length) / 2.0},
+      m_clearance{goal_radius + std::hypot(robot_width, robot_length) / 2.0 + margin}
+{
+    // polygon around the clearance circle, pushed out a bit so its edges don't clip it
+    const double ring {m_clearance / std::cos(M_PI / sides) + 0.5};
+
+    for (int g = 0; g < goal_count; ++g)
+    {
+        for (int k = 0; k < sides; ++k)
+        {
+            int n {g * sides + k};
+            double a {(k + 0.5) * 2.0 * M_PI / sides};
+            m_nodes[n] = {goals[g].x + ring * std::cos(a), goals[g].y + ring * std::sin(a)};
+            m_usable[n] = in_bounds(m_nodes[n]);
+            for (int o = 0; o < goal_count && m_usable[n]; ++o)
+                if (dist(m_nodes[n], {goals[o].x, goals[o].y}) < m_clearance)
+                    m_usable[n] = false;
+        }
+    }
+
+    for (int i = 0; i < node_count; ++i)
+    {
+        m_visible[i][i] = false;
+        for (int j = i + 1; j < node_count; ++j)
+            m_visible[i][j] = m_visible[j][i] = m_usable[i] && m_usable[j] && clear(m_nodes[i], m_nodes[j]);
+    }
+}
+
+bool field_planner::in_bounds(const plan_point &p) const
+{
+    return p.x >= m_robot_radius && p.x <= field_size - m_robot_radius
+        && p.y >= m_robot_radius && p.y <= field_size - m_robot_radius;
+}
+
+bool field_planner::clear(const plan_point &a, const plan_point &b) const
+{
+    for (int g = 0; g < goal_count; ++g)
+    {
+        plan_point c {goals[g].x, goals[g].y};
+        if (dist(a, c) < m_clearance || dist(b, c) < m_clearance)
+            continue;
+        if (segment_dist(a, b, c) < m_clearance)
+            return false;
+    }
+    return true;
+}
+
+int field_planner::plan(const plan_point &start, const plan_point &end, plan_point *out) const
+{
+    if (clear(start, end))
+    {
+        out[0] = start;
+        out[1] = end;
+        return 2;
+    }
+
+    // node_count is the start, node_count + 1 the end
+    constexpr int total {node_count + 2};
+    constexpr int start_id {node_count};
+    constexpr int end_id {node_count + 1};
+
+    auto point = [&](int id) -> const plan_point & {
+        return (id == start_id) ? start : (id == end_id) ? end : m_nodes[id];
+    };
+
+    bool start_sees[node_count], end_sees[node_count];
+    for (int n = 0; n < node_count; ++n)
+    {
+        start_sees[n] = m_usable[n] && clear(start, m_nodes[n]);
+        end_sees[n] = m_usable[n] && clear(m_nodes[n], end);
+    }
+
+    auto visible = [&](int a, int b) {
+        if (a == start_id)
+            return b == end_id ? false : start_sees[b];
+        if (b == end_id)
+            return a == start_id ? false : end_sees[a];
+        if (b == start_id || a == end_id)
+            return false;
+        return m_visible[a][b];
+    };
+
+    // plain array A*, the graph is too small for a heap to pay off
+    double cost[total];
+    int from[total];
+    bool done[total];
+    for (int i = 0; i < total; ++i)
+    {
+        cost[i] = INFINITY;
+        from[i] = -1;
+        done[i] = false;
+    }
+    cost[start_id] = 0.0;
+
+    while (true)
+    {
+        int best {-1};
+        double best_f {INFINITY};
+        for (int i = 0; i < total; ++i)
+        {
+            if (done[i] || cost[i] == INFINITY)
+                continue;
+            double f {cost[i] + dist(point(i), end)};
+            if (f < best_f)
+            {
+                best_f = f;
+                best = i;
+            }
+        }
+
+        if (best == -1)
+            return 0;
+        if (best == end_id)
+            break;
+        done[best] = true;
+
+        for (int n = 0; n < total; ++n)
+        {
+            if (done[n] || !visible(best, n))
+                continue;
+            double c {cost[best] + dist(point(best), point(n))};
+            if (c < cost[n])
+            {
+                cost[n] = c;
+                from[n] = best;
+            }
+        }
+    }
+
+    // walk back from the end, then flip
+    int count {0};
+    for (int id = end_id; id != -1; id = from[id])
+        out[count++] = point(id);
+    for (int i = 0; i < count / 2; ++i)
+    {
+        plan_point tmp {out[i]};
+        out[i] = out[count - 1 - i];
+        out[count - 1 - i] = tmp;
+    }
+
+    return count;
+}
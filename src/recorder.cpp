@@ -0,0 +1,163 @@
+//* flight recorder
+
+//* headers and stuff
+#include "globals.hpp"
+#include "blog.hpp"
+#include "flight_record.hpp"
+#include "inputs.hpp"
+#include "localization.hpp"
+#include "recorder.hpp"
+#include "robot.hpp"
+#include "sorter.hpp"
+#include "main.h"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+//* global vars
+
+static constexpr std::uint32_t ring_size {2048};   // 20.48 s at 10 ms
+static constexpr int update_ms {10};
+static constexpr int max_dumps {100};
+
+static std::array<flight_record, ring_size> ring;
+static std::uint32_t written {0};       // total records ever, ring index is written % ring_size
+static std::uint32_t dumped {0};        // `written` at the last dump
+static pros::Mutex ring_lock;
+
+//* functions
+
+static std::uint16_t pack_buttons(const input_frame &in)
+{
+    return (in.align ? FB_ALIGN : 0) | (in.hold_toggle ? FB_HOLD : 0) | (in.index ? FB_INDEX : 0)
+        | (in.cycle ? FB_CYCLE : 0) | (in.shoot ? FB_SHOOT : 0) | (in.intake ? FB_INTAKE : 0)
+        | (in.eject ? FB_EJECT : 0) | (in.convey_down ? FB_CONVEY_DOWN : 0)
+        | (in.itk_fast ? FB_ITK_FAST : 0) | (in.itk_slow ? FB_ITK_SLOW : 0);
+}
+
+static std::int16_t applied(std::int8_t port)
+{
+    return pack_mv(pros::c::motor_get_voltage(smart_port(port)));
+}
+
+static void record(std::uint32_t now, std::uint32_t late)
+{
+    flight_record r {};
+    r.ms = now;
+
+    auto state {chassis->getState()};   // CARTESIAN, set in build_chassis()
+    r.x = pack_inches(state.x.convert(okapi::inch));
+    r.y = pack_inches(state.y.convert(okapi::inch));
+    r.theta = pack_radians(state.theta.convert(okapi::radian));
+
+    pf_pose estimate {localize_pose()};     // zeros until start_localize() runs
+    r.pf_x = pack_inches(estimate.x);
+    r.pf_y = pack_inches(estimate.y);
+    r.pf_theta = pack_radians(estimate.theta);
+
+    input_frame in {read_inputs()};
+    r.forward = pack_stick(in.forward);
+    r.yaw = pack_stick(in.yaw);
+    r.buttons = pack_buttons(in);
+
+    r.drive_left = applied(drivetrain::left[0]);
+    r.drive_right = applied(drivetrain::right[0]);
+    r.intake = applied(mechanism_ports::intakes[0]);
+    r.convey_top = applied(mechanism_ports::convey_top);
+    r.convey_bot = applied(mechanism_ports::convey_bot);
+    r.battery = static_cast<std::uint16_t>(pros::c::battery_get_voltage());
+    r.late = static_cast<std::uint8_t>(late > 255 ? 255 : late);
+
+    r.flags = (pros::competition::is_autonomous() ? FF_AUTONOMOUS : 0)
+        | (pros::competition::is_disabled() ? FF_DISABLED : 0)
+        | (pros::competition::is_connected() ? FF_FIELD : 0)
+        | (sorter_ejecting() ? FF_EJECTING : 0);
+
+    // a dump holds the lock for a while, drop the frame instead of waiting on the sd card
+    if (!ring_lock.take(0))
+        return;
+    ring[written % ring_size] = r;
+    ++written;
+    ring_lock.give();
+}
+
+static void recorder_loop(void)
+{
+    std::uint32_t now {pros::millis()};
+    while (true)
+    {
+        pros::Task::delay_until(&now, update_ms);
+        std::uint32_t woke {pros::millis()};
+        record(woke, woke - now);
+    }
+}
+
+/// anything that ends in std::terminate (uncaught exception, bad function call...)
+/// gets its last seconds saved before the program goes down
+[[noreturn]] static void on_terminate(void)
+{
+    dump_recorder("terminate");
+    std::abort();
+}
+
+void start_recorder(void)
+{
+    static bool started {false};
+    if (started)
+        return;
+    started = true;
+
+    std::set_terminate(on_terminate);
+    static pros::Task task {recorder_loop, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "recorder"};
+}
+
+bool dump_recorder(const char *reason)
+{
+    ring_lock.take(TIMEOUT_MAX);
+
+    std::uint32_t count {written - dumped < ring_size ? written - dumped : ring_size};
+    if (count == 0)
+    {
+        ring_lock.give();
+        return false;
+    }
+
+    // first free name, so earlier dumps (and earlier boots) are kept
+    char name[32];
+    FILE *file {nullptr};
+    for (int i = 0; i < max_dumps && file == nullptr; ++i)
+    {
+        std::snprintf(name, sizeof(name), "/usd/flight_%d.bin", i);
+        if (FILE *existing {std::fopen(name, "rb")})
+        {
+            std::fclose(existing);
+            continue;
+        }
+        file = std::fopen(name, "wb");
+        if (file == nullptr)
+            break;  // no card
+    }
+    if (file == nullptr)
+    {
+        ring_lock.give();
+        return false;
+    }
+
+    flight_header header {flight_magic, flight_version, sizeof(flight_record), count, pros::millis(), {}};
+    std::strncpy(header.reason, reason, sizeof(header.reason) - 1);
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    // oldest first, the ring may wrap once
+    std::uint32_t start {(written - count) % ring_size};
+    std::uint32_t first {count < ring_size - start ? count : ring_size - start};
+    std::fwrite(&ring[start], sizeof(flight_record), first, file);
+    std::fwrite(&ring[0], sizeof(flight_record), count - first, file);
+    std::fclose(file);
+
+    dumped = written;
+    ring_lock.give();
+    BLOG(BLOG_INFO, BLOG_SYSTEM, "flight recorder: %u frames to %s (%s)", count, name, reason);
+    return true;
+}
@@ -0,0 +1,201 @@
+//* distance sensor wall relocalization
+
+//* headers and stuff
+#include "globals.hpp"
+#include "blog.hpp"
+#include "devices.hpp"
+#include "field.hpp"
+#include "relocalize.hpp"
+#include "robot.hpp"
+#include "main.h"
+
+#include <array>
+#include <cmath>
+
+//* global vars
+
+const std::array<distance_mount, distance_count> distance_mounts {{
+    {sensor_ports::distance[0], -7.0, 0.0, -90.0},  // left side, facing left
+    {sensor_ports::distance[1], 0.0, -7.5, 180.0}   // back, facing backwards
+}};
+
+static constexpr int heading_bins {360};
+static constexpr int update_ms {50};
+static constexpr int min_confidence {45};       // out of 63
+static constexpr double max_incidence {15.0};   // degrees off the wall normal
+static constexpr double gate {3.0};             // inches, expected vs measured
+static constexpr int agree_count {3};           // readings in a row before correcting
+static constexpr double max_step {0.5};         // inches per correction
+
+/// per sensor, per heading bin: beam direction and sensor position relative to the
+/// tracking center, in field axes. built once so an update is a table lookup plus a divide.
+struct beam
+{
+    double dx, dy;  // unit direction
+    double ox, oy;  // rotated mount offset
+};
+
+static std::array<std::array<beam, heading_bins>, distance_count> beams;
+static std::array<int, distance_count> agree {};
+static bool enabled {true};
+static double total {0.0};
+
+//* functions
+
+static void build_beams(void)
+{
+    for (std::size_t s = 0; s < distance_count; ++s)
+    {
+        for (int h = 0; h < heading_bins; ++h)
+        {
+            double theta {h * 2.0 * M_PI / heading_bins};
+            double a {theta + distance_mounts[s].angle * M_PI / 180.0};
+            double c {std::cos(theta)}, sn {std::sin(theta)};
+
+            // clockwise rotation of the mount offset by the robot heading
+            beams[s][h] = beam{
+                std::sin(a), std::cos(a),
+                distance_mounts[s].x * c + distance_mounts[s].y * sn,
+                -distance_mounts[s].x * sn + distance_mounts[s].y * c
+            };
+        }
+    }
+}
+
+/// which wall the beam is square enough to, if any
+static bool facing_wall(const beam &b, wall &out)
+{
+    const double min_cos {std::cos(max_incidence * M_PI / 180.0)};
+
+    if (b.dx >= min_cos)
+        out = wall::RIGHT;
+    else if (b.dx <= -min_cos)
+        out = wall::LEFT;
+    else if (b.dy >= min_cos)
+        out = wall::FAR;
+    else if (b.dy <= -min_cos)
+        out = wall::NEAR;
+    else
+        return false;
+
+    return true;
+}
+
+static double clamp_step(double v)
+{
+    return (v > max_step) ? max_step : (v < -max_step) ? -max_step : v;
+}
+
+static void relocalize_loop(void)
+{
+    std::array<pros::Distance, distance_count> sensors {{
+        pros::Distance{distance_mounts[0].port},
+        pros::Distance{distance_mounts[1].port}
+    }};
+
+    std::uint32_t now {pros::millis()};
+    while (true)
+    {
+        pros::Task::delay_until(&now, update_ms);
+
+        if (!enabled || !chassis)
+            continue;
+
+        auto state {chassis->getState()};   // CARTESIAN, set in build_chassis()
+        double x {state.x.convert(okapi::inch)};
+        double y {state.y.convert(okapi::inch)};
+        double deg {std::fmod(state.theta.convert(okapi::degree), 360.0)};
+        if (deg < 0.0)
+            deg += 360.0;
+        int bin {static_cast<int>(deg * heading_bins / 360.0) % heading_bins};
+
+        double fix_x {0.0}, fix_y {0.0};
+        bool fixed {false};
+
+        for (std::size_t s = 0; s < distance_count; ++s)
+        {
+            const beam &b {beams[s][bin]};
+            wall target;
+            result<double> reading {distance_inches(sensors[s], min_confidence)};
+
+            if (!facing_wall(b, target) || !reading)
+            {
+                agree[s] = 0;
+                continue;
+            }
+
+            double measured {reading.value()};
+            double sx {x + b.ox}, sy {y + b.oy};
+
+            // expected distance along the beam, and what the reading says the coordinate is
+            double expected {}, implied {};
+            switch (target)
+            {
+                case wall::LEFT:
+                    expected = -sx / b.dx;
+                    implied = -measured * b.dx - b.ox;
+                    break;
+                case wall::RIGHT:
+                    expected = (field_size - sx) / b.dx;
+                    implied = field_size - measured * b.dx - b.ox;
+                    break;
+                case wall::NEAR:
+                    expected = -sy / b.dy;
+                    implied = -measured * b.dy - b.oy;
+                    break;
+                case wall::FAR:
+                    expected = (field_size - sy) / b.dy;
+                    implied = field_size - measured * b.dy - b.oy;
+                    break;
+            }
+
+            // anything in the way (goal, robot, ball) reads short, so it fails the gate
+            if (std::abs(expected - measured) > gate)
+            {
+                agree[s] = 0;
+                continue;
+            }
+
+            if (++agree[s] < agree_count)
+                continue;
+
+            if (target == wall::LEFT || target == wall::RIGHT)
+                fix_x = clamp_step(implied - x);
+            else
+                fix_y = clamp_step(implied - y);
+            fixed = true;
+        }
+
+        if (!fixed)
+            continue;
+
+        // re-read right before writing so we only lose whatever odom did in between
+        state = chassis->getState();
+        state.x += fix_x * okapi::inch;
+        state.y += fix_y * okapi::inch;
+        chassis->setState(state);
+        total += std::abs(fix_x) + std::abs(fix_y);
+        BLOG(BLOG_DEBUG, BLOG_ODOM, "relocalized by (%.2f, %.2f) in", fix_x, fix_y);
+    }
+}
+
+void start_relocalize(void)
+{
+    static bool started {false};
+    if (started)
+        return;
+    started = true;
+
+    build_beams();
+    static pros::Task task {relocalize_loop, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "relocalize"};
+}
+
+void set_relocalize(bool on)
+{
+    enabled = on;
+}
+
+double relocalize_total(void)
+{
+    return total;
+}
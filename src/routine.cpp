@@ -0,0 +1,257 @@
+//* autonomous routines
+
+//* headers and stuff
+#include "globals.hpp"
+#include "blog.hpp"
+#include "field.hpp"
+#include "routine.hpp"
+#include "main.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+//* global vars
+
+alliance sel_alliance {alliance::RED};
+
+static std::vector<auto_step> live_red;
+static std::vector<auto_step> live_blue;
+
+//* routines, red side
+
+static auto_step path(std::vector<okapi::PathfinderPoint> points, bool backwards = false)
+{
+    return {step_kind::PATH, std::move(points), backwards, 0_deg, 0, 0, 0, 0, -1, "", {}};
+}
+
+/// `target` is a field pose on the red side, mirrored like start_pose() for blue
+static auto_step route(pf_pose target)
+{
+    return {step_kind::ROUTE, {}, false, 0_deg, 0, 0, 0, 0, -1, "", target};
+}
+
+static auto_step turn(okapi::QAngle angle)
+{
+    return {step_kind::TURN, {}, false, angle, 0, 0, 0, 0, -1, "", {}};
+}
+
+static auto_step mech(int bot, int top, int itk, int ms)
+{
+    return {step_kind::MECH, {}, false, 0_deg, bot, top, itk, ms, -1, "", {}};
+}
+
+static auto_step score(int goal, int ms)
+{
+    return {step_kind::SCORE, {}, false, 0_deg, 600, 600, 0, ms, goal, "", {}};
+}
+
+/// home row corner goal and side goal
+static std::vector<auto_step> live_routine(void)
+{
+    return {
+        mech(0, 0, 600, 300),
+        path({{0_ft, 0_ft, 0_deg}, {2_ft, 0_ft, 0_deg}}),
+        score(0, 800),
+        path({{0_ft, 0_ft, 0_deg}, {1.5_ft, 0_ft, 0_deg}}, true),
+        turn(-135_deg),
+        route({56.75, 8.75, M_PI / 2.0}),   // short of the side goal, facing it along the wall
+        score(1, 800)
+    };
+}
+
+//* functions
+
+template <std::size_t... I>
+static void generate_points(const okapi::PathfinderPoint *points, const std::string &id, std::index_sequence<I...>)
+{
+    profile_controller.get()->generatePath({points[I]...}, id);
+}
+
+result<> generate_path(const okapi::PathfinderPoint *points, std::size_t count, const std::string &id)
+{
+    if (count < 2)
+        return fault::TOO_FEW_POINTS;
+    if (count > 6)
+        return fault::TOO_MANY_POINTS;
+
+    // pathfinder fails (and okapi throws) when two waypoints are on top of each other
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        double dx {(points[i].x - points[i - 1].x).convert(okapi::inch)};
+        double dy {(points[i].y - points[i - 1].y).convert(okapi::inch)};
+        if (std::hypot(dx, dy) < 1.0)
+            return fault::POINTS_TOO_CLOSE;
+    }
+
+#if __cpp_exceptions
+    try
+    {
+#endif
+        switch (count)
+        {
+            case 2: generate_points(points, id, std::make_index_sequence<2>{}); break;
+            case 3: generate_points(points, id, std::make_index_sequence<3>{}); break;
+            case 4: generate_points(points, id, std::make_index_sequence<4>{}); break;
+            case 5: generate_points(points, id, std::make_index_sequence<5>{}); break;
+            case 6: generate_points(points, id, std::make_index_sequence<6>{}); break;
+        }
+#if __cpp_exceptions
+    }
+    catch (const std::exception &)
+    {
+        return fault::IMPOSSIBLE_PATH;
+    }
+#endif
+
+    return {};
+}
+
+result<> load_path(const std::string &directory, const std::string &id)
+{
+    // okapi reads <directory>/<id>.left.csv and .right.csv
+    for (const char *side : {".left.csv", ".right.csv"})
+    {
+        FILE *file {std::fopen((directory + "/" + id + side).c_str(), "r")};
+        if (file == nullptr)
+            return fault::NO_FILE;
+        std::fclose(file);
+    }
+
+    profile_controller.get()->loadPath(directory, id);
+
+    // a file okapi can't parse gets logged and dropped, not thrown
+    std::vector<std::string> loaded {profile_controller.get()->getPaths()};
+    if (std::find(loaded.begin(), loaded.end(), id) == loaded.end())
+        return fault::NOT_LOADED;
+
+    return {};
+}
+
+/// blue starts on the far wall, so its field is red's flipped across the middle
+/// (y -> field_size - y). goals are numbered in rows near to far, so that swaps the rows.
+static constexpr int mirror_goal(int goal)
+{
+    return (goal < 0) ? goal : (2 - goal / 3) * 3 + goal % 3;
+}
+
+static constexpr bool mirror_matches_field(void)
+{
+    for (int g = 0; g < goal_count; ++g)
+    {
+        const goal_pos &red {goals[g]}, &blue {goals[mirror_goal(g)]};
+        double dx {red.x - blue.x}, dy {red.y + blue.y - field_size};
+        if (dx * dx + dy * dy > 1e-6)
+            return false;
+    }
+    return true;
+}
+
+static_assert(mirror_matches_field(), "mirror_goal() doesn't match the goals in field.hpp");
+
+pf_pose start_pose(alliance side)
+{
+    // red home row, back to the wall, facing the corner goal two feet away
+    constexpr pf_pose red {25.0, 25.0, -3.0 * M_PI / 4.0};
+
+    if (side == alliance::RED)
+        return red;
+    return {red.x, field_size - red.y, M_PI - red.theta};   // same flip as mirror_goal()
+}
+
+static auto_step mirror(auto_step step)
+{
+    for (okapi::PathfinderPoint &p : step.points)
+    {
+        p.y = -p.y;
+        p.theta = -p.theta;
+    }
+    step.angle = -step.angle;
+    step.goal = mirror_goal(step.goal);
+    step.target = {step.target.x, field_size - step.target.y, M_PI - step.target.theta};
+    return step;
+}
+
+/// mirrors and generates every path in a routine, ids are `<name>_<step>`
+static void build(std::vector<auto_step> &red, std::vector<auto_step> &blue, const std::string &name)
+{
+    blue.clear();
+    for (std::size_t i = 0; i < red.size(); ++i)
+    {
+        blue.push_back(mirror(red[i]));
+        if (red[i].kind != step_kind::PATH)
+            continue;
+
+        red[i].path_id = name + "_red_" + std::to_string(i);
+        blue[i].path_id = name + "_blue_" + std::to_string(i);
+        for (const auto_step *step : {&red[i], &blue[i]})
+        {
+            result<> made {generate_path(step->points.data(), step->points.size(), step->path_id)};
+            if (!made)
+                BLOG(BLOG_ERROR, BLOG_AUTO, "path %s: %s", step->path_id.c_str(), fault_name(made.error()));
+        }
+    }
+}
+
+void build_routines(void)
+{
+    profile_controller = standby<okapi::AsyncMotionProfileController>{okapi::AsyncMotionProfileControllerBuilder()
+        .withLimits({1.0, 2.0, 10.0})
+        .withOutput(chassis)
+        .buildMotionProfileController()};
+
+    live_red = live_routine();
+    build(live_red, live_blue, "live");
+}
+
+void run_mechanisms(int bot, int top, int itk, int ms)
+{
+    convey_bot.moveVelocity(bot);
+    convey_top.moveVelocity(top);
+    intakes.moveVelocity(itk);
+    pros::delay(ms);
+    convey_bot.moveVelocity(0);
+    convey_top.moveVelocity(0);
+    intakes.moveVelocity(0);
+}
+
+static void run(const std::vector<auto_step> &steps)
+{
+    for (const auto_step &step : steps)
+    {
+        switch (step.kind)
+        {
+            case step_kind::PATH:
+                profile_controller->setTarget(step.path_id, step.backwards);
+                profile_controller.wait();
+                break;
+            case step_kind::ROUTE:
+            {
+                result<> made {route_to({step.target.x, step.target.y}, step.target.theta * okapi::radian, "route")};
+                if (!made)
+                {
+                    // the rest of the routine assumes we got there
+                    BLOG(BLOG_ERROR, BLOG_AUTO, "route to (%.1f, %.1f): %s", step.target.x, step.target.y, fault_name(made.error()));
+                    return;
+                }
+                profile_controller->setTarget("route");
+                profile_controller.wait();
+                profile_controller.get()->removePath("route");
+                break;
+            }
+            case step_kind::TURN:
+                chassis->turnAngle(step.angle);
+                break;
+            case step_kind::MECH:
+            case step_kind::SCORE:
+                run_mechanisms(step.bot, step.top, step.itk, step.ms);
+                break;
+        }
+    }
+}
+
+void run_live(void)
+{
+    run((sel_alliance == alliance::RED) ? live_red : live_blue);
+}
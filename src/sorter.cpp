@@ -0,0 +1,155 @@
+//* ball color sorting
+
+//* headers and stuff
+#include "globals.hpp"
+#include "blog.hpp"
+#include "hot_path.hpp"
+#include "indexer.hpp"
+#include "robot.hpp"
+#include "sorter.hpp"
+#include "main.h"
+
+//* global vars
+
+ball_color our_color {ball_color::RED};
+
+static constexpr int update_ms {5};
+
+// proximity hysteresis, a ball is "in" above enter and "out" again below leave
+static constexpr std::int32_t prox_enter {180};
+static constexpr std::int32_t prox_leave {120};
+
+// hue bands, wide ones to keep a color once we have it, narrow ones to pick it up
+static constexpr double red_enter {15.0}, red_keep {30.0};      // hue <= x or >= 360 - x
+static constexpr double blue_low_enter {200.0}, blue_high_enter {240.0};
+static constexpr double blue_low_keep {180.0}, blue_high_keep {260.0};
+
+// inches of convey_top travel to keep reversing for once an eject starts, and how long
+// to give it before stopping anyway (missed ball, jammed roller)
+static constexpr double eject_for {4.0};
+static constexpr std::uint32_t eject_timeout_ms {400};
+
+static ball_tracker tracker {conveyor_per_count, conveyor_per_count, conveyor_split, conveyor_exit};
+static pros::Mutex tracker_lock;
+
+static volatile bool enabled {true};
+static volatile bool ejecting {false};
+
+//* functions
+
+static ball_color classify(double hue, ball_color current)
+{
+    bool red {current == ball_color::RED
+        ? (hue <= red_keep || hue >= 360.0 - red_keep)
+        : (hue <= red_enter || hue >= 360.0 - red_enter)};
+    bool blue {current == ball_color::BLUE
+        ? (hue >= blue_low_keep && hue <= blue_high_keep)
+        : (hue >= blue_low_enter && hue <= blue_high_enter)};
+
+    if (red)
+        return ball_color::RED;
+    if (blue)
+        return ball_color::BLUE;
+    return current;
+}
+
+static const char *color_name(ball_color color)
+{
+    return color == ball_color::RED ? "red" : color == ball_color::BLUE ? "blue" : "unknown";
+}
+
+static void sorter_loop(void)
+{
+    register_control_loop("sorter");
+
+    pros::Optical optical {sensor_ports::optical};
+    optical.disable_gesture();
+    optical.set_led_pwm(100);
+
+    bool present {false};
+    ball_color color {ball_color::NONE};
+    double eject_end {0.0};
+    std::uint32_t eject_timeout {0};
+
+    std::uint32_t now {pros::millis()};
+    while (true)
+    {
+        pros::Task::delay_until(&now, update_ms);
+        realtime_region frame;
+
+        double bot {convey_bot.getPosition()};
+        double top {convey_top.getPosition()};
+        std::int32_t prox {optical.get_proximity()};
+
+        tracker_lock.take(TIMEOUT_MAX);
+        tracker.update(bot, top);
+
+        // a ball showed up, watch its color until it's gone
+        if (!present && prox >= prox_enter)
+        {
+            present = true;
+            color = ball_color::NONE;
+        }
+        if (present)
+            color = classify(optical.get_hue(), color);
+
+        // it's gone, decide now so we don't get fooled by the next ball's edge
+        if (present && prox <= prox_leave)
+        {
+            present = false;
+            bool added {tracker.add(color, now)};
+            BLOG(BLOG_DEBUG, BLOG_SORTER, "%s ball at %u ms%s", color_name(color), now, added ? "" : ", tracker full");
+        }
+
+        // highest ball is the wrong color and reached the top roller
+        if (enabled && tracker.size() > 0 && tracker[0].position >= eject_position
+            && tracker[0].color != ball_color::NONE && tracker[0].color != our_color)
+        {
+            std::uint32_t seen {tracker[0].seen_ms};
+            tracker.pop();
+            eject_end = top - eject_for / conveyor_per_count;
+            eject_timeout = now + eject_timeout_ms;
+            ejecting = true;
+            index_cancel();     // controls stops it, the index controller isn't ours to touch
+            BLOG(BLOG_INFO, BLOG_SORTER, "ejecting, seen %u ms ago, %d balls left", now - seen, tracker.size());
+        }
+        tracker_lock.give();
+
+        // stop the roller ourselves, controls() only takes it back in teleop
+        if (ejecting && (top <= eject_end || now >= eject_timeout))
+        {
+            convey_top.moveVelocity(0);
+            ejecting = false;
+        }
+        else if (ejecting)     // every frame, the index drives it until controls stops it and index_stop() zeroes it after
+            convey_top.moveVelocity(-600);
+    }
+}
+
+void start_sorter(void)
+{
+    static bool started {false};
+    if (started)
+        return;
+    started = true;
+
+    static pros::Task task {sorter_loop, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "sorter"};
+}
+
+void set_sorter(bool on)
+{
+    enabled = on;
+}
+
+bool sorter_ejecting(void)
+{
+    return ejecting;
+}
+
+ball_tracker tracked_balls(void)
+{
+    tracker_lock.take(TIMEOUT_MAX);
+    ball_tracker copy {tracker};
+    tracker_lock.give();
+    return copy;
+}
@@ -2,68 +2,164 @@
 
 //* headers and stuff
 #include "globals.hpp"
+#include "align.hpp"
+#include "devices.hpp"
+#include "hot_path.hpp"
+#include "indexer.hpp"
+#include "inputs.hpp"
+#include "sorter.hpp"
 #include "main.h"
 
+#include <cmath>
+
 //* global vars
 
 int cycle_delay {0};
 
+// heading hold, kicks in when the turn stick is inside the band
+static constexpr double hold_band {0.08};
+static constexpr double hold_kp {0.025}, hold_kd {0.12};   // per degree, per degree per frame
+static constexpr int hold_settle {15};                      // frames after a turn before locking
+
 //* functions
 
 /// regular move
 void regular_move(int bot, int top, int itk)
 {
+    index_stop();   // any other command cancels an index
     convey_bot.moveVelocity(bot);
-    convey_top.moveVelocity(top);
+    if (!sorter_ejecting())     // sorter owns the top roller while it throws a ball out
+        convey_top.moveVelocity(top);
     intakes.moveVelocity(itk);
 }
 
+/// heading in degrees, imu if it's there, odom otherwise
+double drive_heading(void)
+{
+    result<double> rotation {imu_rotation(imu)};
+    if (!rotation)
+        return chassis->getState().theta.convert(okapi::degree);
+    return rotation.value();
+}
+
 /// driving
 void driving(void)
 {
+    bool hold_enabled {true};
+    bool toggle_held {false};
+    bool locked {false};
+    int settle {0};
+    double target {0.0};
+    double last_error {0.0};
+    bool aligning {false};
+    std::uint32_t seen {0};
+
+    register_control_loop("driving");
+
     while (!(pros::competition::is_autonomous() || pros::competition::is_disabled()))
     {
-        chassis->getModel()->arcade(
-            controller.getAnalog(okapi::ControllerAnalog::rightY),
-            controller.getAnalog(okapi::ControllerAnalog::rightX),
-            10.0
-        );
-        pros::delay(10);
+        realtime_region frame;
+        input_frame input {next_inputs(seen)};
+        double forward {input.forward};
+        double yaw {input.yaw};
+
+        // auto align while A is held and the sticks are left alone, any stick input takes over
+        bool sticks {std::abs(forward) > hold_band || std::abs(yaw) > hold_band};
+        if (input.align && !sticks)
+        {
+            if (!aligning)
+                align_start();
+            aligning = true;
+            locked = false;
+            settle = 0;
+
+            align_step();
+            continue;
+        }
+        aligning = false;
+
+        bool toggle {input.hold_toggle};   // heading hold on/off
+        if (toggle && !toggle_held)
+            hold_enabled = !hold_enabled;
+        toggle_held = toggle;
+
+        // driver is turning, or barely moving: hand control back and wait for it to settle
+        if (!hold_enabled || std::abs(yaw) > hold_band || std::abs(forward) < hold_band)
+        {
+            locked = false;
+            settle = 0;
+        }
+        else if (!locked && ++settle >= hold_settle)
+        {
+            locked = true;
+            target = drive_heading();
+            last_error = 0.0;
+        }
+
+        if (locked)
+        {
+            double error {target - drive_heading()};
+            yaw = hold_kp * error + hold_kd * (error - last_error);
+            yaw = (yaw > hold_band) ? hold_band : (yaw < -hold_band) ? -hold_band : yaw;
+            last_error = error;
+        }
+
+        if (locked)
+            drive_model->driveVector(forward, yaw);
+        else
+            drive_model->arcade(forward, yaw, 0.05);
     }
 }
 
 void controls(void)
 {
     int log_time {0};
+    std::uint32_t seen {0};
+    bool index_held {false};
+
+    register_control_loop("controls");
 
     while (!(pros::competition::is_autonomous() || pros::competition::is_disabled()))
     {
-        if (controller.getDigital(okapi::ControllerDigital::R1))        // index
-            regular_move(600, 600, 0);
-        else if (controller.getDigital(okapi::ControllerDigital::R2))   // cycle
+        realtime_region frame;
+        input_frame input {next_inputs(seen)};
+        bool index_pressed {input.index};
+
+        if (index_pressed)                                              // index one slot
+        {
+            if (!index_held)
+                index_step(1);
+            intakes.moveVelocity(0);
+        }
+        else if (input.cycle)                                           // cycle
             {
                 ++log_time;
                 regular_move(600, 600, (log_time >= cycle_delay) ? 600 : 0);
             }
-        else if (controller.getDigital(okapi::ControllerDigital::L1))   // shoot
+        else if (input.shoot)                                           // shoot
             regular_move(600, 600, 0);
-        else if (controller.getDigital(okapi::ControllerDigital::L2))   // intake
+        else if (input.intake)                                          // intake
             regular_move(0, 0, 600);
-        else if (controller.getDigital(okapi::ControllerDigital::up))   // eject
+        else if (input.eject)                                           // eject
             regular_move(-600, -600, -600);
-        else if (controller.getDigital(okapi::ControllerDigital::down)) // convey down
+        else if (input.convey_down)                                     // convey down
             regular_move(-600, -600, 0);
-        else if (controller.getDigital(okapi::ControllerDigital::left)) // itk eject fast
+        else if (input.itk_fast)                                        // itk eject fast
             regular_move(0, 0, -600);
-        else if (controller.getDigital(okapi::ControllerDigital::right))    // itk eject slow
+        else if (input.itk_slow)                                        // itk eject slow
             regular_move(0, 0, -200);
+        else if (indexing())                                            // let the index finish
+        {
+            log_time = 0;
+            intakes.moveVelocity(0);
+        }
         else
         {
             log_time = 0;
             regular_move(0, 0, 0);
         }
-        
-        pros::delay(10);
+
+        index_held = index_pressed;
     }
 }
 
@@ -0,0 +1,107 @@
+//* allocation free tracking wheel odometry
+
+//* headers and stuff
+#include "robot.hpp"
+#include "tracking.hpp"
+#include "main.h"
+
+#include <cstdlib>
+
+//* functions
+
+tracking_wheels::tracking_wheels(pros::ADIEncoder left, pros::ADIEncoder right, pros::ADIEncoder middle)
+    : m_left{left}, m_right{right}, m_middle{middle}
+{
+
+}
+
+void tracking_wheels::read(tracking_ticks &out) const
+{
+    out[0] = m_left.get_value();
+    out[1] = m_right.get_value();
+    out[2] = m_middle.get_value();
+}
+
+std::valarray<std::int32_t> tracking_wheels::getSensorVals() const
+{
+    tracking_ticks ticks;
+    read(ticks);
+    return {ticks[0], ticks[1], ticks[2]};
+}
+
+void tracking_wheels::reset(void)
+{
+    m_left.reset();
+    m_right.reset();
+    m_middle.reset();
+}
+
+tracking_odometry::tracking_odometry(std::shared_ptr<tracking_wheels> wheels, const okapi::ChassisScales &scales)
+    : m_wheels{std::move(wheels)}, m_scales{scales}
+{
+    setScales(scales);
+}
+
+void tracking_odometry::setScales(const okapi::ChassisScales &scales)
+{
+    // the wheels are fixed in robot.hpp, only the middle offset gets calibrated
+    tracking_scales tracking {tracking_layout::scales};
+    tracking.middle_offset = scales.middleWheelDistance.convert(okapi::inch);
+
+    m_scales_lock.take(TIMEOUT_MAX);
+    m_scales = scales;
+    m_tracking = tracking;
+    m_scales_lock.give();
+}
+
+void tracking_odometry::step()
+{
+    tracking_ticks now;
+    m_wheels->read(now);
+
+    if (!m_primed)
+    {
+        m_last = now;
+        m_primed = true;
+        return;
+    }
+
+    tracking_ticks diff {now[0] - m_last[0], now[1] - m_last[1], now[2] - m_last[2]};
+    m_last = now;
+
+    if (std::abs(diff[0]) > max_tick_diff || std::abs(diff[1]) > max_tick_diff || std::abs(diff[2]) > max_tick_diff)
+        return;
+
+    m_scales_lock.take(TIMEOUT_MAX);
+    arc_step(diff, m_tracking, m_pose);
+    m_scales_lock.give();
+}
+
+okapi::OdomState tracking_odometry::getState(const okapi::StateMode &mode) const
+{
+    if (mode == okapi::StateMode::FRAME_TRANSFORMATION)
+        return {m_pose.x * okapi::inch, m_pose.y * okapi::inch, m_pose.theta * okapi::radian};
+    return {m_pose.y * okapi::inch, m_pose.x * okapi::inch, m_pose.theta * okapi::radian};
+}
+
+void tracking_odometry::setState(const okapi::OdomState &state, const okapi::StateMode &mode)
+{
+    double x {state.x.convert(okapi::inch)}, y {state.y.convert(okapi::inch)};
+    if (mode == okapi::StateMode::FRAME_TRANSFORMATION)
+        m_pose = {x, y, state.theta.convert(okapi::radian)};
+    else
+        m_pose = {y, x, state.theta.convert(okapi::radian)};
+}
+
+std::shared_ptr<okapi::ReadOnlyChassisModel> tracking_odometry::getModel()
+{
+    return m_wheels;
+}
+
+okapi::ChassisScales tracking_odometry::getScales()
+{
+    m_scales_lock.take(TIMEOUT_MAX);
+    okapi::ChassisScales out {m_scales};
+    m_scales_lock.give();
+    return out;
+}
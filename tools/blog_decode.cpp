@@ -0,0 +1,239 @@
+//* binary log decoder
+// turns a /usd/blog_<n>.bin into text. the format strings aren't in the log, only the
+// address of each log site, so it needs the elf that was running (bin/hot.package.elf,
+// or bin/monolith.elf without hot/cold linking). a log from a different build decodes to
+// garbage or "unknown site", keep the elf with the log.
+// build from the repo root:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/blog_decode.cpp -o blog_decode
+//   ./blog_decode bin/hot.package.elf blog_0.bin
+
+//* headers and stuff
+#include "blog_format.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//* elf lookup
+// just enough elf32 to map an address in the image back to bytes in the file
+
+struct section
+{
+    std::uint32_t addr, offset, size;
+};
+
+static std::vector<std::uint8_t> elf;
+static std::vector<section> sections;
+
+template <typename T>
+static T read_at(std::size_t offset)
+{
+    T value {};
+    if (offset + sizeof(T) <= elf.size())
+        std::memcpy(&value, elf.data() + offset, sizeof(T));
+    return value;
+}
+
+static bool load_elf(const char *path)
+{
+    FILE *file {std::fopen(path, "rb")};
+    if (file == nullptr)
+        return false;
+    std::fseek(file, 0, SEEK_END);
+    elf.resize(std::ftell(file));
+    std::fseek(file, 0, SEEK_SET);
+    std::size_t got {std::fread(elf.data(), 1, elf.size(), file)};
+    std::fclose(file);
+
+    // 32 bit, little endian
+    if (got != elf.size() || elf.size() < 52 || std::memcmp(elf.data(), "\x7f" "ELF", 4) != 0 || elf[4] != 1 || elf[5] != 1)
+        return false;
+
+    std::uint32_t shoff {read_at<std::uint32_t>(32)};
+    std::uint16_t shentsize {read_at<std::uint16_t>(46)};
+    std::uint16_t shnum {read_at<std::uint16_t>(48)};
+    for (int i = 0; i < shnum; ++i)
+    {
+        std::size_t at {shoff + static_cast<std::size_t>(i) * shentsize};
+        std::uint32_t type {read_at<std::uint32_t>(at + 4)};
+        std::uint32_t flags {read_at<std::uint32_t>(at + 8)};
+        if (type != 1 || !(flags & 2))     // PROGBITS and ALLOC, i.e. actually in the image
+            continue;
+        sections.push_back({read_at<std::uint32_t>(at + 12), read_at<std::uint32_t>(at + 16), read_at<std::uint32_t>(at + 20)});
+    }
+    return true;
+}
+
+/// file offset of an image address, 0 if it's not in the elf
+static std::size_t offset_of(std::uint32_t addr, std::uint32_t size)
+{
+    for (const section &s : sections)
+        if (addr >= s.addr && addr + size <= s.addr + s.size)
+            return s.offset + (addr - s.addr);
+    return 0;
+}
+
+static std::string string_at(std::uint32_t addr)
+{
+    std::size_t at {offset_of(addr, 1)};
+    if (at == 0)
+        return "?";
+    std::string out;
+    while (at < elf.size() && elf[at] != 0)
+        out += static_cast<char>(elf[at++]);
+    return out;
+}
+
+//* formatting
+
+struct arg
+{
+    blog_tag tag;
+    std::int64_t i;
+    std::uint64_t u;
+    double f;
+    std::string s;
+};
+
+static std::vector<arg> parse_args(const std::uint8_t *p, std::size_t size)
+{
+    std::vector<arg> out;
+    std::size_t at {0};
+    while (at < size)
+    {
+        arg a {static_cast<blog_tag>(p[at++]), 0, 0, 0.0, {}};
+        switch (a.tag)
+        {
+            case BT_I32: { std::int32_t v; std::memcpy(&v, p + at, 4); a.i = v; at += 4; break; }
+            case BT_U32: { std::uint32_t v; std::memcpy(&v, p + at, 4); a.u = v; at += 4; break; }
+            case BT_I64: std::memcpy(&a.i, p + at, 8); at += 8; break;
+            case BT_U64: std::memcpy(&a.u, p + at, 8); at += 8; break;
+            case BT_F64: std::memcpy(&a.f, p + at, 8); at += 8; break;
+            case BT_STR: a.s.assign(reinterpret_cast<const char *>(p + at + 1), p[at]); at += 1 + p[at]; break;
+            default: return out;    // corrupt
+        }
+        out.push_back(a);
+    }
+    return out;
+}
+
+/// printf on the host, with the argument's own type deciding how it's read
+static std::string render(const std::string &format, const std::vector<arg> &args)
+{
+    std::string out;
+    std::size_t next {0};
+    for (std::size_t i = 0; i < format.size(); ++i)
+    {
+        if (format[i] != '%')
+        {
+            out += format[i];
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '%')
+        {
+            out += '%';
+            ++i;
+            continue;
+        }
+
+        // flags, width, precision kept, length modifiers dropped
+        std::string spec {"%"};
+        std::size_t j {i + 1};
+        while (j < format.size() && std::strchr("-+ #0123456789.", format[j]))
+            spec += format[j++];
+        while (j < format.size() && std::strchr("hlLqjzt", format[j]))
+            ++j;
+        if (j >= format.size())
+            break;
+        char conv {format[j]};
+        i = j;
+
+        if (next >= args.size())
+        {
+            out += "<missing>";
+            continue;
+        }
+        const arg &a {args[next++]};
+
+        char buf[128];
+        bool is_float {a.tag == BT_F64};
+        bool is_signed {a.tag == BT_I32 || a.tag == BT_I64};
+        if (a.tag == BT_STR)
+            std::snprintf(buf, sizeof(buf), (spec + 's').c_str(), a.s.c_str());
+        else if (std::strchr("fFeEgGaA", conv))
+            std::snprintf(buf, sizeof(buf), (spec + conv).c_str(), is_float ? a.f : is_signed ? double(a.i) : double(a.u));
+        else if (std::strchr("di", conv) || (std::strchr("cs", conv) && !is_float))
+            std::snprintf(buf, sizeof(buf), (spec + "lld").c_str(), is_float ? (long long)a.f : is_signed ? (long long)a.i : (long long)a.u);
+        else if (std::strchr("uxXo", conv))
+            std::snprintf(buf, sizeof(buf), (spec + "ll" + conv).c_str(), is_float ? (unsigned long long)a.f : is_signed ? (unsigned long long)a.i : (unsigned long long)a.u);
+        else
+            std::snprintf(buf, sizeof(buf), "%g", a.f);
+        out += buf;
+    }
+    return out;
+}
+
+//* functions
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: %s <elf> blog_<n>.bin\n", argv[0]);
+        return 1;
+    }
+    if (!load_elf(argv[1]))
+    {
+        std::fprintf(stderr, "%s: not a 32 bit little endian elf\n", argv[1]);
+        return 1;
+    }
+
+    FILE *file {std::fopen(argv[2], "rb")};
+    if (file == nullptr)
+    {
+        std::perror(argv[2]);
+        return 1;
+    }
+
+    blog_header header {};
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != blog_magic || header.version != blog_version)
+    {
+        std::fprintf(stderr, "%s: not a version %d binary log\n", argv[2], blog_version);
+        return 1;
+    }
+
+    static const char *levels[] {"debug", "info", "warn", "error"};
+    static const char *categories[] {"system", "auto", "drive", "odom", "sorter", "hot_path"};
+
+    std::uint8_t head[9];
+    std::uint8_t payload[256];
+    while (std::fread(head, 1, 9, file) == 9)
+    {
+        std::uint32_t site, ms;
+        std::memcpy(&site, head, 4);
+        std::memcpy(&ms, head + 4, 4);
+        if (std::fread(payload, 1, head[8], file) != head[8])
+            break;
+
+        // blog_site on the brain: u32 format, u32 file, u16 line, u8 level, u8 category
+        std::size_t at {offset_of(site, 12)};
+        if (at == 0)
+        {
+            std::printf("%10.3f unknown site 0x%08x\n", ms / 1000.0, site);
+            continue;
+        }
+        std::string format {string_at(read_at<std::uint32_t>(at))};
+        std::string source {string_at(read_at<std::uint32_t>(at + 4))};
+        std::uint16_t line {read_at<std::uint16_t>(at + 8)};
+        std::uint8_t level {read_at<std::uint8_t>(at + 10)};
+        std::uint8_t category {read_at<std::uint8_t>(at + 11)};
+
+        std::printf("%10.3f %-5s %-8s %s (%s:%d)\n", ms / 1000.0,
+            level < 4 ? levels[level] : "?", category < 6 ? categories[category] : "?",
+            render(format, parse_args(payload, head[8])).c_str(), source.c_str(), line);
+    }
+
+    std::fclose(file);
+    return 0;
+}
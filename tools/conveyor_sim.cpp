@@ -0,0 +1,159 @@
+//* host side conveyor throughput sim
+// steps the intake + two stage conveyor in 1 ms ticks with the same R2 logic as controls()
+// (frame counter, 10 ms frames) and sweeps cycle_delay, stage speeds and how the intake is
+// staggered. prints the best settings by balls scored per second.
+// build from the repo root:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/conveyor_sim.cpp -o conveyor_sim
+
+//* headers and stuff
+#include "ball_tracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//* global vars
+
+static constexpr double tick {0.001};           // seconds
+static constexpr double frame {0.010};          // controls() loop period
+static constexpr double motor_tau {0.06};       // first order motor response
+static constexpr double load_drop {0.08};       // fraction of speed lost per ball on a stage
+static constexpr double intake_length {6.0};    // goal bottom to the optical sensor, inches
+static constexpr double intake_diameter {3.25}; // intake roller, inches
+static constexpr double descore_gap {0.15};     // time for the next goal ball to drop down
+static constexpr double score_gap {0.18};     // balls closer together than this at the top bounce off the goal
+static constexpr double time_limit {10.0};
+
+enum class stagger
+{
+    START_DELAY,    // what controls() does now: intake waits cycle_delay frames once
+    PULSE,          // intake on/off, cycle_delay frames each
+    SLOW_INTAKE     // intake at a fraction of full speed once started
+};
+
+static const char *stagger_names[] {"start delay", "pulse", "slow intake"};
+
+struct settings
+{
+    int cycle_delay;
+    double bot_rpm, top_rpm, intake_rpm;
+    stagger mode;
+};
+
+struct result
+{
+    settings s;
+    int scored;
+    double time;
+    double rate;
+};
+
+//* functions
+
+static double surface_speed(double rpm, double diameter)
+{
+    return rpm / 60.0 * M_PI * diameter;    // inches per second
+}
+
+/// one R2 press: robot holds two balls, three more sitting in the goal to descore
+static result run(const settings &s)
+{
+    std::vector<double> balls {conveyor_split + 2.0, 1.0};  // positions, highest first
+    int in_goal {3};
+    double next_descore {0.0};
+
+    double bot {0.0}, top {0.0}, itk {0.0};    // actual rpm
+    int log_time {0};
+    double next_frame {0.0};
+    double itk_cmd {0.0};
+    int scored {0};
+    double last_exit {-INFINITY};
+
+    for (double t = 0.0; t < time_limit; t += tick)
+    {
+        // controls() only runs every 10 ms
+        if (t >= next_frame)
+        {
+            next_frame += frame;
+            ++log_time;
+
+            bool on {log_time >= s.cycle_delay};
+            if (s.mode == stagger::PULSE)
+                on = s.cycle_delay == 0 || (log_time / std::max(s.cycle_delay, 1)) % 2 == 1;
+            itk_cmd = on ? (s.mode == stagger::SLOW_INTAKE ? s.intake_rpm * 0.6 : s.intake_rpm) : 0.0;
+        }
+
+        int on_bot {0}, on_top {0};
+        for (double p : balls)
+            (p < conveyor_split ? on_bot : on_top) += (p >= 0.0) ? 1 : 0;
+
+        bot += (s.bot_rpm * (1.0 - load_drop * on_bot) - bot) * tick / motor_tau;
+        top += (s.top_rpm * (1.0 - load_drop * on_top) - top) * tick / motor_tau;
+        itk += (itk_cmd - itk) * tick / motor_tau;
+
+        // move highest first, nobody gets closer than a ball to the one above
+        double above {INFINITY};
+        for (double &p : balls)
+        {
+            double speed {p < 0.0 ? surface_speed(itk, intake_diameter)
+                : p < conveyor_split ? surface_speed(bot, conveyor_roller_diameter)
+                : surface_speed(top, conveyor_roller_diameter)};
+            p = std::min(p + speed * tick, above - ball_diameter);
+            above = p;
+        }
+
+        // top one leaves the robot
+        if (!balls.empty() && balls.front() > conveyor_exit)
+        {
+            balls.erase(balls.begin());
+            if (t - last_exit >= score_gap)
+                ++scored;
+            last_exit = t;
+        }
+
+        // intake grabs the next goal ball once there's room and it has dropped down
+        bool room {balls.empty() || balls.back() > -intake_length + ball_diameter};
+        if (in_goal > 0 && itk > 50.0 && room && t >= next_descore)
+        {
+            balls.push_back(-intake_length);
+            --in_goal;
+            next_descore = t + descore_gap;
+        }
+
+        if (balls.empty() && in_goal == 0)
+            break;
+    }
+
+    double time {last_exit > 0.0 ? last_exit : time_limit};  // until the robot is empty
+    return {s, scored, time, scored / time};
+}
+
+int main(void)
+{
+    std::vector<result> results;
+    for (int mode = 0; mode < 3; ++mode)
+        for (int delay = 0; delay <= 40; delay += 2)
+            for (double bot = 300.0; bot <= 600.0; bot += 100.0)
+                for (double top = 300.0; top <= 600.0; top += 100.0)
+                    results.push_back(run({delay, bot, top, 600.0, static_cast<stagger>(mode)}));
+
+    // most balls actually in the goal first, then fastest
+    std::sort(results.begin(), results.end(), [](const result &a, const result &b) {
+        if (a.scored != b.scored)
+            return a.scored > b.scored;
+        return a.rate > b.rate;
+    });
+
+    std::printf("%-12s %6s %6s %6s %7s %8s\n", "stagger", "delay", "bot", "top", "scored", "balls/s");
+    for (std::size_t i = 0; i < 15 && i < results.size(); ++i)
+    {
+        const result &r {results[i]};
+        std::printf("%-12s %6d %6.0f %6.0f %7d %8.2f\n", stagger_names[static_cast<int>(r.s.mode)],
+            r.s.cycle_delay, r.s.bot_rpm, r.s.top_rpm, r.scored, r.rate);
+    }
+
+    result current {run({0, 600.0, 600.0, 600.0, stagger::START_DELAY})};
+    std::printf("\ncurrent teleop (delay 0, 600/600): %d balls, %.2f balls/s\n", current.scored, current.rate);
+    return 0;
+}
@@ -0,0 +1,130 @@
+//* host side drive command benchmark
+// times arcade() the way okapi's SkidSteerModel gets there (virtual model -> virtual motor
+// group -> virtual motor, one hop per layer) against skid_steer_model, both ending in the
+// same fake motor write. okapi itself is prebuilt for the brain so its classes are mirrored
+// here with the same shape. build from the repo root:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/drive_model_bench.cpp -o drive_model_bench
+
+//* headers and stuff
+#include "skid_steer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+//* fake hardware
+
+static volatile std::int32_t motor_out[22];
+
+struct fake_io
+{
+    static void velocity(std::uint8_t port, std::int32_t rpm) { motor_out[port] = rpm; }
+    static void voltage(std::uint8_t port, std::int32_t mv) { motor_out[port] = mv; }
+    static void reversed(std::uint8_t, bool) {}
+    static void gearing(std::uint8_t, okapi::AbstractMotor::gearset) {}
+    static void brake(std::uint8_t, okapi::AbstractMotor::brakeMode) {}
+    static void units(std::uint8_t, okapi::AbstractMotor::encoderUnits) {}
+};
+
+struct fake_sensors
+{
+    std::valarray<std::int32_t> getSensorVals(void) const { return {0, 0, 0}; }
+    void reset(void) {}
+};
+
+//* okapi shaped generic path
+
+struct motor_base
+{
+    virtual ~motor_base() = default;
+    virtual std::int32_t moveVoltage(std::int16_t mv) = 0;
+};
+
+struct motor : motor_base
+{
+    explicit motor(std::uint8_t port) : m_port{port} {}
+    std::int32_t moveVoltage(std::int16_t mv) override { motor_out[m_port] = mv; return 1; }
+    std::uint8_t m_port;
+};
+
+struct motor_group : motor_base
+{
+    std::int32_t moveVoltage(std::int16_t mv) override
+    {
+        std::int32_t out {1};
+        for (auto &m : m_motors)
+            out &= m->moveVoltage(mv);
+        return out;
+    }
+    std::vector<std::shared_ptr<motor_base>> m_motors;
+};
+
+struct model_base
+{
+    virtual ~model_base() = default;
+    virtual void arcade(double forward_speed, double yaw, double threshold) = 0;
+};
+
+struct generic_model : model_base
+{
+    void arcade(double forward_speed, double yaw, double threshold) override
+    {
+        forward_speed = std::clamp(forward_speed, -1.0, 1.0);
+        if (std::abs(forward_speed) < threshold)
+            forward_speed = 0.0;
+        yaw = std::clamp(yaw, -1.0, 1.0);
+        if (std::abs(yaw) < threshold)
+            yaw = 0.0;
+
+        const double max_input {std::copysign(std::max(std::abs(forward_speed), std::abs(yaw)), forward_speed)};
+        double left {forward_speed + yaw}, right {forward_speed - yaw};
+        if ((forward_speed >= 0.0) == (yaw >= 0.0))
+            left = max_input;
+        else
+            right = max_input;
+
+        m_left->moveVoltage(static_cast<std::int16_t>(std::clamp(left, -1.0, 1.0) * 12000.0));
+        m_right->moveVoltage(static_cast<std::int16_t>(std::clamp(right, -1.0, 1.0) * 12000.0));
+    }
+    std::shared_ptr<motor_base> m_left, m_right;
+};
+
+//* functions
+
+template <typename F>
+static double time_ns(F &&command)
+{
+    constexpr int commands {10000000};
+    auto start {std::chrono::steady_clock::now()};
+    for (int i = 0; i < commands; ++i)
+        command((i & 255) / 255.0, ((i * 7) & 255) / 255.0 - 0.5);
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::nano>(end - start).count() / commands;
+}
+
+int main(void)
+{
+    auto left {std::make_shared<motor_group>()}, right {std::make_shared<motor_group>()};
+    for (auto port : drivetrain::left)
+        left->m_motors.push_back(std::make_shared<motor>(smart_port(port)));
+    for (auto port : drivetrain::right)
+        right->m_motors.push_back(std::make_shared<motor>(smart_port(port)));
+
+    // held through the base class, the way chassis->getModel() hands it out
+    std::shared_ptr<model_base> generic {std::make_shared<generic_model>()};
+    static_cast<generic_model &>(*generic).m_left = left;
+    static_cast<generic_model &>(*generic).m_right = right;
+
+    auto model {std::make_shared<skid_steer_model<drivetrain, fake_sensors, fake_io>>(std::make_shared<fake_sensors>())};
+    okapi::ChassisModel &as_base {*model};
+
+    const double generic_ns {time_ns([&](double f, double y) { generic->arcade(f, y, 0.0); })};
+    const double base_ns {time_ns([&](double f, double y) { as_base.arcade(f, y, 0.0); })};
+    const double direct_ns {time_ns([&](double f, double y) { model->arcade(f, y, 0.0); })};
+
+    std::printf("generic (model -> group -> motor):  %6.2f ns/command\n", generic_ns);
+    std::printf("skid_steer_model via ChassisModel:  %6.2f ns/command\n", base_ns);
+    std::printf("skid_steer_model direct:            %6.2f ns/command\n", direct_ns);
+    return 0;
+}
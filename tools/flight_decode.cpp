@@ -0,0 +1,91 @@
+//* flight recorder dump decoder
+// turns a /usd/flight_<n>.bin dump into a csv (stdout) plus a short summary (stderr):
+// how long it covers, dropped frames, worst recorder lateness and the lowest battery.
+// build from the repo root:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/flight_decode.cpp -o flight_decode
+//   ./flight_decode flight_0.bin > flight_0.csv
+
+//* headers and stuff
+#include "flight_record.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//* functions
+
+static const char *button_names[] {"align", "hold", "index", "cycle", "shoot", "intake", "eject", "down", "fast", "slow"};
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: %s flight_<n>.bin\n", argv[0]);
+        return 1;
+    }
+
+    FILE *file {std::fopen(argv[1], "rb")};
+    if (file == nullptr)
+    {
+        std::perror(argv[1]);
+        return 1;
+    }
+
+    flight_header header {};
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != flight_magic)
+    {
+        std::fprintf(stderr, "%s: not a flight recorder dump\n", argv[1]);
+        return 1;
+    }
+    if (header.version != flight_version || header.record_size != sizeof(flight_record))
+    {
+        std::fprintf(stderr, "%s: version %d, record size %d, this decoder reads version %d (%zu bytes)\n",
+            argv[1], header.version, header.record_size, flight_version, sizeof(flight_record));
+        return 1;
+    }
+
+    std::vector<flight_record> records(header.count);
+    std::size_t read {std::fread(records.data(), sizeof(flight_record), header.count, file)};
+    std::fclose(file);
+    records.resize(read);
+    if (read != header.count)
+        std::fprintf(stderr, "warning: header says %u records, file has %zu\n", header.count, read);
+
+    std::printf("ms,x,y,theta_deg,pf_x,pf_y,pf_theta_deg,forward,yaw,buttons,drive_left_mv,drive_right_mv,intake_mv,"
+                "convey_top_mv,convey_bot_mv,battery_mv,late_ms,auto,disabled,field,ejecting\n");
+
+    int dropped {0}, worst_late {0};
+    int min_battery {65535};
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        const flight_record &r {records[i]};
+        if (i > 0 && r.ms - records[i - 1].ms > 15)
+            dropped += (r.ms - records[i - 1].ms) / 10 - 1;
+        worst_late = r.late > worst_late ? r.late : worst_late;
+        min_battery = r.battery < min_battery ? r.battery : min_battery;
+
+        char buttons[80] {};
+        for (int b = 0; b < 10; ++b)
+        {
+            if (!(r.buttons & (1 << b)))
+                continue;
+            if (buttons[0] != '\0')
+                std::snprintf(buttons + std::strlen(buttons), sizeof(buttons) - std::strlen(buttons), "|");
+            std::snprintf(buttons + std::strlen(buttons), sizeof(buttons) - std::strlen(buttons), "%s", button_names[b]);
+        }
+
+        std::printf("%u,%.2f,%.2f,%.1f,%.2f,%.2f,%.1f,%.2f,%.2f,%s,%d,%d,%d,%d,%d,%u,%u,%d,%d,%d,%d\n",
+            r.ms, r.x / 100.0, r.y / 100.0, r.theta / 1000.0 * 180.0 / M_PI,
+            r.pf_x / 100.0, r.pf_y / 100.0, r.pf_theta / 1000.0 * 180.0 / M_PI,
+            r.forward / 127.0, r.yaw / 127.0, buttons,
+            r.drive_left, r.drive_right, r.intake, r.convey_top, r.convey_bot, r.battery, r.late,
+            (r.flags & FF_AUTONOMOUS) != 0, (r.flags & FF_DISABLED) != 0,
+            (r.flags & FF_FIELD) != 0, (r.flags & FF_EJECTING) != 0);
+    }
+
+    if (!records.empty())
+        std::fprintf(stderr, "%s: \"%s\", %zu frames, %.2f s ending at %u ms, %d dropped, worst late %d ms, battery low %d mV\n",
+            argv[1], header.reason, records.size(), (records.back().ms - records.front().ms) / 1000.0,
+            records.back().ms, dropped, worst_late, min_battery);
+    return 0;
+}
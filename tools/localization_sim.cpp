@@ -0,0 +1,143 @@
+//* host side particle filter check
+// runs the filter against simulated sensors, prints the pose error over time.
+// build from the repo root:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/localization_sim.cpp src/particle_filter.cpp -o localization_sim
+// add -DALLOC_WATCH to report heap allocations inside the filter update, the same check the
+// brain runs on its control loops (-DALLOC_WATCH_STRICT to stop at the first one).
+
+//* headers and stuff
+#define ALLOC_WATCH_HOOKS
+#include "alloc_watch.hpp"
+#include "field.hpp"
+#include "particle_filter.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+//* allocation watch
+// the whole sim is one thread, so the counts are only switched on around the update
+
+static alloc_counts update_counts {"filter update", 0, 0, 0, {}, 0, false};
+static bool watching {false};
+
+alloc_counts *alloc_watch_counts(void)
+{
+    return watching ? &update_counts : nullptr;
+}
+
+void alloc_watch_report(const alloc_counts &counts, void *site, std::size_t size)
+{
+    std::fprintf(stderr, "%s: %zu byte allocation in a realtime region from %p\n", counts.name, size, site);
+}
+
+//* functions
+
+/// true distance from a sensor to the walls
+static double ray(const pf_pose &p, const pf_mount &m)
+{
+    double sx {p.x + m.x * std::cos(p.theta) + m.y * std::sin(p.theta)};
+    double sy {p.y - m.x * std::sin(p.theta) + m.y * std::cos(p.theta)};
+    double dx {std::sin(p.theta + m.angle)}, dy {std::cos(p.theta + m.angle)};
+    double tx {std::abs(dx) < 1e-9 ? 1e9 : ((dx > 0 ? field_size : 0.0) - sx) / dx};
+    double ty {std::abs(dy) < 1e-9 ? 1e9 : ((dy > 0 ? field_size : 0.0) - sy) / dy};
+    return std::min(tx, ty);
+}
+
+/// bearing from the camera to the closest goal in view, false if none
+static bool goal_bearing(const pf_pose &p, const pf_mount &cam, double fov, double &bearing)
+{
+    double cx {p.x + cam.x * std::cos(p.theta) + cam.y * std::sin(p.theta)};
+    double cy {p.y - cam.x * std::sin(p.theta) + cam.y * std::cos(p.theta)};
+    double best {1e9};
+    for (const goal_pos &g : goals)
+    {
+        double b {std::atan2(g.x - cx, g.y - cy) - (p.theta + cam.angle)};
+        b = std::atan2(std::sin(b), std::cos(b));
+        double d {std::hypot(g.x - cx, g.y - cy)};
+        if (std::abs(b) < fov / 2 && d < best)
+        {
+            best = d;
+            bearing = b;
+        }
+    }
+    return best < 1e9;
+}
+
+int main(void)
+{
+    std::mt19937 rng {1104};
+    std::normal_distribution<double> noise {0.0, 1.0};
+
+    const pf_mount left {-7.0, 0.0, -M_PI / 2};
+    const pf_mount back {0.0, -7.5, M_PI};
+    const pf_mount camera {0.0, 6.0, 0.0};
+    const double fov {61.0 * M_PI / 180.0};
+
+    pf_pose truth {24.0, 24.0, 0.0};
+    particle_filter filter;
+    filter.init(truth, 1.0, 0.02);
+
+    // odometry that drifts: 3% scale error on forward, a little heading bias
+    pf_pose odom {truth};
+    double worst {0.0}, sum_sq {0.0};
+    int steps {0};
+    double busy_us {0.0};
+
+    for (int t = 0; t < 3000; ++t)    // 60 s at 20 ms
+    {
+        double forward {0.6}, turn {(t / 150) % 2 ? 0.02 : 0.0};
+        // bounce off the walls
+        double nx {truth.x + forward * std::sin(truth.theta)}, ny {truth.y + forward * std::cos(truth.theta)};
+        if (nx < 15 || nx > field_size - 15 || ny < 15 || ny > field_size - 15)
+        {
+            forward = 0.0;
+            turn = 0.1;
+        }
+
+        truth.x += forward * std::sin(truth.theta);
+        truth.y += forward * std::cos(truth.theta);
+        truth.theta += turn;
+
+        double odom_forward {forward * 1.03 + 0.01 * noise(rng)};
+        double odom_turn {turn + 0.0005 + 0.001 * noise(rng)};
+        odom.theta += odom_turn;
+
+        auto start {std::chrono::steady_clock::now()};
+        watching = true;
+        realtime_region frame;
+
+        filter.predict(odom_forward, 0.0, odom_turn, 0.05 + 0.1 * std::abs(odom_forward), 0.002 + 0.05 * std::abs(odom_turn));
+        filter.observe_heading(truth.theta + 0.01 * noise(rng), 0.03);
+        filter.observe_distance(left, ray(truth, left) + 0.5 * noise(rng), 1.0);
+        filter.observe_distance(back, ray(truth, back) + 0.5 * noise(rng), 1.0);
+
+        double bearing {};
+        if (goal_bearing(truth, camera, fov, bearing))
+            filter.observe_goal(camera, bearing + 0.01 * noise(rng), 0.05);
+
+        if (filter.effective_size() < particle_filter::capacity / 2)
+            filter.resample();
+        pf_pose est {filter.estimate()};
+        watching = false;
+
+        busy_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        double err {std::hypot(est.x - truth.x, est.y - truth.y)};
+        worst = std::max(worst, err);
+        sum_sq += err * err;
+        ++steps;
+
+        if (t % 500 == 0)
+            std::printf("t=%5.1fs truth=(%6.1f, %6.1f) est=(%6.1f, %6.1f) err=%.2f in\n",
+                t * 0.02, truth.x, truth.y, est.x, est.y, err);
+    }
+
+    std::printf("rms error %.2f in, worst %.2f in, %.1f us per update (host)\n",
+        std::sqrt(sum_sq / steps), worst, busy_us / steps);
+#ifdef ALLOC_WATCH
+    std::printf("%u allocations in %d updates\n", update_counts.total, steps);
+#endif
+    return 0;
+}
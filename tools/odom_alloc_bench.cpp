@@ -0,0 +1,130 @@
+//* host side odom step benchmark
+// times the encoder read and tick diff of an odom step the way okapi does it (valarray sensor
+// read by value, valarray tick buffers) against tracking_odometry's fixed arrays, and counts
+// heap allocations per step. arc_step is timed on its own since both run the same one.
+// build from the repo root:
+//   g++ -std=gnu++17 -O2 -Iinclude tools/odom_alloc_bench.cpp -o odom_alloc_bench
+
+//* headers and stuff
+#include "tracking_math.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <valarray>
+
+//* allocation counting
+
+static std::size_t allocations {0};
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+//* fake encoders
+
+static std::int32_t ticks[3] {0, 0, 0};
+
+static void advance(int i)
+{
+    ticks[0] += 3 + (i & 1);
+    ticks[1] += 3;
+    ticks[2] += (i & 3) - 1;
+}
+
+/// what okapi's getSensorVals() looks like
+__attribute__((noinline)) static std::valarray<std::int32_t> sensor_vals(void)
+{
+    return std::valarray<std::int32_t>{ticks[0], ticks[1], ticks[2]};
+}
+
+/// what tracking_wheels::read() looks like
+__attribute__((noinline)) static void read(tracking_ticks &out)
+{
+    out = {ticks[0], ticks[1], ticks[2]};
+}
+
+//* functions
+
+static double ns_since(std::chrono::steady_clock::time_point start, int steps)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / steps;
+}
+
+int main(void)
+{
+    constexpr int steps {1000000};
+    constexpr tracking_scales scales {make_tracking_scales(2.75, 2.75, 360.0, 12.0, 6.0)};
+
+    // okapi style read and tick diff, the only part the two versions do differently
+    std::valarray<std::int32_t> new_ticks {0, 0, 0}, tick_diff {0, 0, 0}, last_ticks {0, 0, 0};
+    std::int64_t valarray_sum[3] {0, 0, 0};
+    allocations = 0;
+    auto start {std::chrono::steady_clock::now()};
+    for (int i = 0; i < steps; ++i)
+    {
+        advance(i);
+        new_ticks = sensor_vals();
+        tick_diff = new_ticks - last_ticks;
+        last_ticks = new_ticks;
+        for (int w = 0; w < 3; ++w)
+            valarray_sum[w] += tick_diff[w];
+    }
+    double valarray_ns {ns_since(start, steps)};
+    double valarray_allocs {static_cast<double>(allocations) / steps};
+
+    // fixed arrays
+    ticks[0] = ticks[1] = ticks[2] = 0;
+    tracking_ticks now {}, last {};
+    std::int64_t array_sum[3] {0, 0, 0};
+    allocations = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i)
+    {
+        advance(i);
+        read(now);
+        tracking_ticks diff {now[0] - last[0], now[1] - last[1], now[2] - last[2]};
+        last = now;
+        for (int w = 0; w < 3; ++w)
+            array_sum[w] += diff[w];
+    }
+    double array_ns {ns_since(start, steps)};
+    double array_allocs {static_cast<double>(allocations) / steps};
+
+    // arc_step on its own, both versions run the same one, for scale
+    ticks[0] = ticks[1] = ticks[2] = 0;
+    tracking_pose pose {0.0, 0.0, 0.0};
+    last = {};
+    allocations = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i)
+    {
+        advance(i);
+        read(now);
+        arc_step({now[0] - last[0], now[1] - last[1], now[2] - last[2]}, scales, pose);
+        last = now;
+    }
+    double arc_ns {ns_since(start, steps) - array_ns};
+
+    bool same {valarray_sum[0] == array_sum[0] && valarray_sum[1] == array_sum[1] && valarray_sum[2] == array_sum[2]};
+    std::printf("read + diff, valarray: %6.1f ns/step, %.2f allocations/step\n", valarray_ns, valarray_allocs);
+    std::printf("read + diff, array:    %6.1f ns/step, %.2f allocations/step\n", array_ns, array_allocs);
+    std::printf("arc_step (same in both): ~%.1f ns/step, %.2f allocations/step\n", arc_ns, static_cast<double>(allocations) / steps);
+    std::printf("same ticks: %s, pose (%.3f, %.3f)\n", same ? "yes" : "no", pose.x, pose.y);
+    return 0;
+}
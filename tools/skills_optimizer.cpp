@@ -0,0 +1,290 @@
+//* host side skills route optimizer
+// tries every goal order (branch and bound, split across cores) using drive times from
+// the field planner and our profile limits, then writes the fastest one as a bundle of
+// okapi path csvs, one path per leg, for AsyncMotionProfileController::loadPath.
+// build from the repo root:
+//   g++ -std=gnu++17 -O2 -pthread -Iinclude tools/skills_optimizer.cpp src/planner.cpp -o skills_optimizer
+// run:
+//   ./skills_optimizer [out dir] [max vel m/s] [max accel m/s^2] [start x in] [start y in] [start heading deg]
+// then copy the out dir to the sd card as /usd/skills.
+
+//* headers and stuff
+#include "field.hpp"
+#include "planner.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+//* global vars
+
+static constexpr double inch {0.0254};      // meters
+static constexpr double dt {0.010};         // same as okapi's generatePath
+static constexpr double wheel_track {12.0}; // inches, same as the chassis scales
+static constexpr double standoff {14.0};    // goal center to robot center when scoring
+static constexpr double score_time {1.5};   // seconds spent at each goal
+static constexpr int nodes {goal_count + 1};// goals plus the start
+
+static double max_vel {1.0};
+static double max_accel {2.0};
+
+struct pose
+{
+    double x, y, theta;   // inches, radians clockwise from +y
+};
+
+struct sample
+{
+    double left, right;   // wheel velocities, m/s
+};
+
+//* functions
+
+/// trapezoid (or triangle) profile over `distance` meters, velocity per tick
+static std::vector<double> trapezoid(double distance, double vel, double accel)
+{
+    std::vector<double> out;
+    double d {std::abs(distance)};
+    double sign {distance < 0.0 ? -1.0 : 1.0};
+    if (d < 1e-6)
+        return out;
+
+    double peak {std::min(vel, std::sqrt(d * accel))};
+    double ramp {peak / accel};
+    double cruise {(d - peak * ramp) / peak};
+    double total {2.0 * ramp + cruise};
+
+    for (double t = dt; t < total + dt; t += dt)
+    {
+        double v {(t < ramp) ? accel * t : (t < ramp + cruise) ? peak : accel * (total - t)};
+        out.push_back(sign * std::max(v, 0.0));
+    }
+
+    // fix up rounding so the wheels travel exactly `distance`
+    double travelled {0.0};
+    for (double v : out)
+        travelled += v * dt;
+    if (std::abs(travelled) > 1e-9)
+        for (double &v : out)
+            v *= distance / travelled;
+
+    return out;
+}
+
+static double profile_time(double distance, double vel, double accel)
+{
+    double d {std::abs(distance)};
+    double peak {std::min(vel, std::sqrt(d * accel))};
+    return (peak > 0.0) ? 2.0 * peak / accel + (d - peak * peak / accel) / peak : 0.0;
+}
+
+static double wrap(double a)
+{
+    return std::atan2(std::sin(a), std::cos(a));
+}
+
+/// where the robot sits to score a goal, facing it from the field center side
+static pose score_pose(int goal)
+{
+    double gx {goals[goal].x}, gy {goals[goal].y};
+    double ax {field_size / 2 - gx}, ay {field_size / 2 - gy};
+    if (std::hypot(ax, ay) < 1e-6)  // center goal, come at it from the near side
+        ay = -1.0;
+    double len {std::hypot(ax, ay)};
+    pose p {gx + ax / len * standoff, gy + ay / len * standoff, 0.0};
+    p.theta = std::atan2(gx - p.x, gy - p.y);
+    return p;
+}
+
+/// turn-then-drive legs along the planned route, appended to `out`. returns the time.
+static double leg(const field_planner &planner, const pose &from, const pose &to, std::vector<sample> *out)
+{
+    plan_point route[field_planner::max_route];
+    int count {planner.plan({from.x, from.y}, {to.x, to.y}, route)};
+    if (count < 2)
+        return INFINITY;
+
+    const double turn_vel {max_vel}, turn_accel {max_accel};
+    double heading {from.theta};
+    double time {0.0};
+
+    auto turn = [&](double target) {
+        double arc {wrap(target - heading) * wheel_track / 2.0 * inch};
+        time += profile_time(arc, turn_vel, turn_accel);
+        if (out)
+            for (double v : trapezoid(arc, turn_vel, turn_accel))
+                out->push_back({v, -v});
+        heading = target;
+    };
+
+    for (int i = 1; i < count; ++i)
+    {
+        double dx {route[i].x - route[i - 1].x}, dy {route[i].y - route[i - 1].y};
+        turn(std::atan2(dx, dy));
+
+        double d {std::hypot(dx, dy) * inch};
+        time += profile_time(d, max_vel, max_accel);
+        if (out)
+            for (double v : trapezoid(d, max_vel, max_accel))
+                out->push_back({v, v});
+    }
+    turn(to.theta);
+
+    return time;
+}
+
+/// okapi/pathfinder csv, only velocity is used when following but fill the rest in anyway
+static bool write_csv(const std::string &file, const std::vector<sample> &samples, bool left)
+{
+    FILE *f {std::fopen(file.c_str(), "w")};
+    if (f == nullptr)
+        return false;
+
+    std::fprintf(f, "dt,x,y,position,velocity,acceleration,jerk,heading\n");
+    double position {0.0}, last {0.0};
+    for (const sample &s : samples)
+    {
+        double v {left ? s.left : s.right};
+        position += v * dt;
+        std::fprintf(f, "%f,%f,%f,%f,%f,%f,%f,%f\n", dt, 0.0, 0.0, position, v, (v - last) / dt, 0.0, 0.0);
+        last = v;
+    }
+
+    std::fclose(f);
+    return true;
+}
+
+//* search
+
+struct search
+{
+    double cost[nodes][nodes];  // [from][to], node goal_count is the start
+    double cheapest_in[goal_count];
+    std::atomic<double> best {INFINITY};
+    std::atomic<int> next_first {0};
+
+    std::vector<int> best_order;
+    std::atomic_flag order_lock = ATOMIC_FLAG_INIT;
+
+    void dfs(int at, unsigned visited, double so_far, std::vector<int> &order)
+    {
+        if (static_cast<int>(order.size()) == goal_count)
+        {
+            double current {best.load()};
+            while (so_far < current && !best.compare_exchange_weak(current, so_far));
+            if (so_far <= current)
+            {
+                while (order_lock.test_and_set());
+                if (so_far <= best.load())
+                    best_order = order;
+                order_lock.clear();
+            }
+            return;
+        }
+
+        // every goal left still has to be driven into at least this cheaply
+        double bound {so_far};
+        for (int g = 0; g < goal_count; ++g)
+            if (!(visited & (1u << g)))
+                bound += cheapest_in[g];
+        if (bound >= best.load())
+            return;
+
+        for (int g = 0; g < goal_count; ++g)
+        {
+            if (visited & (1u << g))
+                continue;
+            order.push_back(g);
+            dfs(g, visited | (1u << g), so_far + cost[at][g], order);
+            order.pop_back();
+        }
+    }
+
+    void worker(void)
+    {
+        std::vector<int> order;
+        for (int first = next_first++; first < goal_count; first = next_first++)
+        {
+            order.assign(1, first);
+            dfs(first, 1u << first, cost[goal_count][first], order);
+        }
+    }
+};
+
+int main(int argc, char **argv)
+{
+    std::string dir {argc > 1 ? argv[1] : "skills"};
+    if (argc > 2) max_vel = std::atof(argv[2]);
+    if (argc > 3) max_accel = std::atof(argv[3]);
+    pose start {
+        argc > 4 ? std::atof(argv[4]) : 36.0,
+        argc > 5 ? std::atof(argv[5]) : 12.0,
+        (argc > 6 ? std::atof(argv[6]) : 0.0) * M_PI / 180.0
+    };
+
+    const field_planner planner {18.0, 18.0};
+    static search s;
+
+    for (int from = 0; from < nodes; ++from)
+    {
+        pose a {from == goal_count ? start : score_pose(from)};
+        for (int to = 0; to < goal_count; ++to)
+            s.cost[from][to] = (from == to) ? INFINITY : leg(planner, a, score_pose(to), nullptr) + score_time;
+    }
+    for (int to = 0; to < goal_count; ++to)
+    {
+        s.cheapest_in[to] = INFINITY;
+        for (int from = 0; from < nodes; ++from)
+            s.cheapest_in[to] = std::min(s.cheapest_in[to], s.cost[from][to]);
+    }
+
+    unsigned cores {std::max(1u, std::thread::hardware_concurrency())};
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < cores; ++i)
+        threads.emplace_back([] { s.worker(); });
+    for (std::thread &t : threads)
+        t.join();
+
+    if (s.best_order.empty())
+    {
+        std::fprintf(stderr, "no route\n");
+        return 1;
+    }
+
+    std::printf("best order (%.2f s incl. %.1f s per goal):", s.best.load(), score_time);
+    for (int g : s.best_order)
+        std::printf(" %d", g);
+    std::printf("\n");
+
+    std::string mkdir {"mkdir -p '" + dir + "'"};
+    if (std::system(mkdir.c_str()) != 0)
+        return 1;
+
+    FILE *index {std::fopen((dir + "/route.txt").c_str(), "w")};
+    pose at {start};
+    for (std::size_t i = 0; i < s.best_order.size(); ++i)
+    {
+        pose to {score_pose(s.best_order[i])};
+        std::vector<sample> samples;
+        leg(planner, at, to, &samples);
+
+        std::string id {"skills_" + std::to_string(i)};
+        if (!write_csv(dir + "/" + id + ".left.csv", samples, true) || !write_csv(dir + "/" + id + ".right.csv", samples, false))
+        {
+            std::fprintf(stderr, "couldn't write %s\n", id.c_str());
+            return 1;
+        }
+        if (index)
+            std::fprintf(index, "%s %d\n", id.c_str(), s.best_order[i]);
+        at = to;
+    }
+    if (index)
+        std::fclose(index);
+
+    std::printf("wrote %zu legs to %s/\n", s.best_order.size(), dir.c_str());
+    return 0;
+}
@@ -0,0 +1,124 @@
+//* host side velocity step response fit
+// fits a first order plus dead time model to the open loop voltage step that
+// tune_mechanisms() logs (/usd/step_<port>_open.csv) and suggests PI gains with the SIMC
+// rules. SIMC wants the plant on its own, so the closed loop before/after logs (the
+// firmware's velocity loop is already in those) are refused.
+// the gains come out in mV per rpm, the firmware's gain units aren't documented, so treat
+// them as a seed for the on robot tuner or for a velocity loop of our own on moveVoltage.
+// build from the repo root:
+//   g++ -std=gnu++17 -O2 tools/vel_pid_fit.cpp -o vel_pid_fit
+// run:
+//   ./vel_pid_fit step_15_open.csv [more.csv ...]
+
+//* headers and stuff
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//* functions
+
+struct point
+{
+    double t;       // seconds
+    double mv;      // applied voltage
+    double rpm;
+};
+
+static bool read_log(const char *name, std::vector<point> &out)
+{
+    FILE *file {std::fopen(name, "r")};
+    if (file == nullptr)
+    {
+        std::perror(name);
+        return false;
+    }
+
+    char header[128];
+    if (std::fgets(header, sizeof(header), file) == nullptr || std::strncmp(header, "t_ms,mv,rpm", 11) != 0)
+    {
+        std::fprintf(stderr, "%s: not an open loop step log (t_ms,mv,rpm)\n", name);
+        std::fclose(file);
+        return false;
+    }
+
+    double t {}, mv {}, rpm {};
+    while (std::fscanf(file, "%lf,%lf,%lf", &t, &mv, &rpm) == 3)
+        out.push_back({t / 1000.0, mv, rpm});
+
+    std::fclose(file);
+    return !out.empty();
+}
+
+/// response of K * (1 - e^(-(t - L) / tau)) to a unit step
+static double unit_response(double t, double delay, double tau)
+{
+    return (t <= delay) ? 0.0 : 1.0 - std::exp(-(t - delay) / tau);
+}
+
+static void fit(const char *name, const std::vector<point> &log)
+{
+    double best_err {INFINITY}, best_k {0.0}, best_delay {0.0}, best_tau {0.0};
+
+    for (double delay = 0.0; delay <= 0.1; delay += 0.005)
+    {
+        for (double tau = 0.005; tau <= 0.4; tau += 0.002)
+        {
+            // gain has a closed form once delay and tau are fixed
+            double num {0.0}, den {0.0};
+            for (const point &p : log)
+            {
+                double u {p.mv * unit_response(p.t, delay, tau)};
+                num += u * p.rpm;
+                den += u * u;
+            }
+            if (den <= 0.0)
+                continue;
+
+            double k {num / den};
+            double err {0.0};
+            for (const point &p : log)
+            {
+                double e {p.rpm - k * p.mv * unit_response(p.t, delay, tau)};
+                err += e * e;
+            }
+
+            if (err < best_err)
+            {
+                best_err = err;
+                best_k = k;
+                best_delay = delay;
+                best_tau = tau;
+            }
+        }
+    }
+
+    // SIMC with the closed loop time constant set to the dead time (or 10 ms, whichever's bigger)
+    double tau_c {std::max(best_delay, 0.01)};
+    double kc {best_tau / (best_k * (tau_c + best_delay))};
+    double ti {std::min(best_tau, 4.0 * (tau_c + best_delay))};
+
+    std::printf("%s\n", name);
+    std::printf("  model: gain %.4f rpm/mV, dead time %.0f ms, time constant %.0f ms (rms %.1f rpm)\n",
+        best_k, best_delay * 1000.0, best_tau * 1000.0, std::sqrt(best_err / log.size()));
+    std::printf("  SIMC PI: kp %.2f mV/rpm, ki %.2f mV/rpm/s, 10 ms loop ki %.3f\n", kc, kc / ti, kc / ti * 0.01);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s step_<port>_open.csv [...]\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::vector<point> log;
+        if (!read_log(argv[i], log))
+            continue;
+        fit(argv[i], log);
+    }
+
+    return 0;
+}